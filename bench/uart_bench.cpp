@@ -0,0 +1,493 @@
+#include "uart_dma.h"
+#include "uart_driver.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define UART_BENCH_HAVE_TSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define UART_BENCH_HAVE_TSC 1
+#else
+#define UART_BENCH_HAVE_TSC 0
+#endif
+
+/**
+ * uart_bench - data path microbenchmarks with JSON output
+ *
+ * Every case starts from a freshly initialized driver whose rings have been
+ * advanced to the requested wrap position and filled to the requested level;
+ * only the operation under test is timed. Per-call timer overhead is measured
+ * up front and subtracted. Results go to stdout as one JSON document.
+ *
+ * The "polled" and "dma" paths time a whole burst larger than the FIFO,
+ * device side included: writeData with simulateTransmit until the burst is
+ * queued, or simulateReceive with readData until it is read. "polled" makes
+ * one application call per FIFO-sized chunk; "dma" moves the same bytes
+ * through a descriptor chain, so the two show the CPU cost DMA saves.
+ *
+ * Usage: uart_bench [--samples N] [--quick]
+ *
+ * --quick runs a small sweep with 200 samples per case unless --samples is
+ * also given, in either order.
+ */
+
+using namespace uart;
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+enum Operation {
+    OP_WRITE_BYTE,
+    OP_WRITE_DATA,
+    OP_READ_BYTE,
+    OP_READ_DATA,
+    OP_READ_UNTIL,
+    OP_SIMULATE_RECEIVE,
+    OP_SIMULATE_TRANSMIT
+};
+
+const char* operationName(Operation op) {
+    switch (op) {
+        case OP_WRITE_BYTE:        return "writeByte";
+        case OP_WRITE_DATA:        return "writeData";
+        case OP_READ_BYTE:         return "readByte";
+        case OP_READ_DATA:         return "readData";
+        case OP_READ_UNTIL:        return "readUntil";
+        case OP_SIMULATE_RECEIVE:  return "simulateReceive";
+        case OP_SIMULATE_TRANSMIT: return "simulateTransmit";
+    }
+    return "unknown";
+}
+
+// Operations that consume from a ring start with size extra bytes queued
+bool consumes(Operation op) {
+    return op == OP_READ_BYTE || op == OP_READ_DATA || op == OP_READ_UNTIL || op == OP_SIMULATE_TRANSMIT;
+}
+
+bool usesTx(Operation op) {
+    return op == OP_WRITE_BYTE || op == OP_WRITE_DATA || op == OP_SIMULATE_TRANSMIT;
+}
+
+enum Path {
+    PATH_FIFO,           // Hardware FIFO only
+    PATH_SOFTWARE_TIER,  // Software buffers behind the FIFO
+    PATH_POLLED,         // Burst moved by application calls, both sides timed
+    PATH_DMA             // Same burst moved by a descriptor chain
+};
+
+const char* pathName(Path path) {
+    switch (path) {
+        case PATH_FIFO:          return "fifo";
+        case PATH_SOFTWARE_TIER: return "software_tier";
+        case PATH_POLLED:        return "polled";
+        case PATH_DMA:           return "dma";
+    }
+    return "unknown";
+}
+
+// Bytes per descriptor in the DMA path's chains
+const size_t DMA_BLOCK = 256;
+
+struct BenchCase {
+    Operation op;
+    Path path;
+    size_t size;   // Bytes moved by the timed operation
+    size_t fill;   // Ring level before the operation, excluding bytes it consumes
+    size_t wrap;   // Ring index at which the operation starts
+};
+
+struct Sample {
+    double ns;
+    double cycles;
+};
+
+uint64_t readCycles() {
+#if UART_BENCH_HAVE_TSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+struct TimerOverhead {
+    double ns;
+    double cycles;
+};
+
+double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    size_t index = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+    return sorted[index];
+}
+
+TimerOverhead measureOverhead(size_t samples) {
+    std::vector<double> ns(samples);
+    std::vector<double> cycles(samples);
+    for (size_t i = 0; i < samples; i++) {
+        uint64_t c0 = readCycles();
+        Clock::time_point t0 = Clock::now();
+        Clock::time_point t1 = Clock::now();
+        uint64_t c1 = readCycles();
+        ns[i] = std::chrono::duration<double, std::nano>(t1 - t0).count();
+        cycles[i] = static_cast<double>(c1 - c0);
+    }
+    std::sort(ns.begin(), ns.end());
+    std::sort(cycles.begin(), cycles.end());
+    TimerOverhead overhead = {percentile(ns, 0.5), percentile(cycles, 0.5)};
+    return overhead;
+}
+
+class Bench {
+public:
+    Bench(size_t samples, const TimerOverhead& overhead)
+        : samples(samples)
+        , overhead(overhead)
+        , payload(64 * 1024)
+        , text(64 * 1024)
+        , scratch(64 * 1024) {
+        for (size_t i = 0; i < payload.size(); i++) {
+            payload[i] = static_cast<uint8_t>(i * 31 + 7);
+            text[i] = static_cast<uint8_t>('a' + i % 26);
+        }
+        tier_config.tx_capacity = 8 * 1024;
+        tier_config.rx_capacity = 8 * 1024;
+    }
+
+    void run(const BenchCase& bc, std::string& json, bool& first) {
+        std::vector<Sample> results;
+        results.reserve(samples);
+        UARTDriver uart;
+        // Only DMA cases attach the controller; it changes the refill path
+        std::unique_ptr<UARTDma> dma;
+        if (bc.path == PATH_DMA) {
+            dma.reset(new UARTDma(uart));
+        }
+        for (size_t i = 0; i < samples; i++) {
+            prepare(uart, bc);
+            results.push_back(measure(uart, dma.get(), bc));
+        }
+        append(bc, results, json, first);
+    }
+
+private:
+    size_t samples;
+    TimerOverhead overhead;
+    std::vector<uint8_t> payload;
+    std::vector<uint8_t> text;      // Line content without newlines
+    std::vector<uint8_t> scratch;
+    SoftwareBufferConfig tier_config;
+    std::vector<DmaDescriptor> chain;
+
+    // Put the driver in the state the case starts from (untimed)
+    void prepare(UARTDriver& uart, const BenchCase& bc) {
+        uart.initialize(115200);
+        if (bc.path == PATH_SOFTWARE_TIER) {
+            uart.attachSoftwareBuffers(tier_config);
+        }
+        if (bc.path == PATH_DMA) {
+            buildChain(usesTx(bc.op) ? payload.data() : scratch.data(), bc.size);
+        }
+
+        // Advance ring indices to the wrap position
+        if (usesTx(bc.op)) {
+            uart.writeData(payload.data(), bc.wrap);
+            uart.simulateTransmit(bc.wrap);
+        } else {
+            uart.simulateReceive(payload.data(), bc.wrap);
+            uart.readData(scratch.data(), bc.wrap);
+        }
+
+        size_t level = bc.fill + (consumes(bc.op) ? bc.size : 0);
+        if (bc.op == OP_READ_UNTIL) {
+            // One line of exactly size bytes, then fill bytes of the next
+            const uint8_t newline = '\n';
+            uart.simulateReceive(text.data(), bc.size - 1);
+            uart.simulateReceive(&newline, 1);
+            uart.simulateReceive(text.data(), bc.fill);
+        } else if (usesTx(bc.op)) {
+            uart.writeData(payload.data(), level);
+        } else {
+            uart.simulateReceive(payload.data(), level);
+        }
+    }
+
+    // Split [buffer, buffer + length) over DMA_BLOCK-sized descriptors
+    void buildChain(uint8_t* buffer, size_t length) {
+        chain.resize((length + DMA_BLOCK - 1) / DMA_BLOCK);
+        for (size_t i = 0; i < chain.size(); i++) {
+            size_t offset = i * DMA_BLOCK;
+            chain[i].buffer = buffer + offset;
+            chain[i].length = std::min(DMA_BLOCK, length - offset);
+            chain[i].next = (i + 1 < chain.size()) ? &chain[i + 1] : nullptr;
+        }
+    }
+
+    // Burst through the FIFO, one application call per chunk
+    static void runPolled(UARTDriver& uart, const BenchCase& bc, const uint8_t* src, uint8_t* dst) {
+        size_t n = bc.size;
+        if (usesTx(bc.op)) {
+            size_t sent = uart.writeData(src, n);
+            while (sent < n) {
+                uart.simulateTransmit(FIFO_DEPTH);
+                sent += uart.writeData(src + sent, n - sent);
+            }
+        } else {
+            size_t delivered = 0;
+            size_t got = 0;
+            while (got < n) {
+                size_t chunk = std::min(FIFO_DEPTH, n - delivered);
+                uart.simulateReceive(src + delivered, chunk);
+                delivered += chunk;
+                got += uart.readData(dst + got, n - got);
+            }
+        }
+    }
+
+    // The same burst through the chain built by prepare()
+    void runDma(UARTDriver& uart, UARTDma& dma, const BenchCase& bc, const uint8_t* src) {
+        if (usesTx(bc.op)) {
+            dma.startTx(&chain[0]);
+            while (dma.isBusy(DMA_CHANNEL_TX)) {
+                uart.simulateTransmit(FIFO_DEPTH);
+            }
+        } else {
+            size_t delivered = 0;
+            dma.startRx(&chain[0]);
+            while (dma.isBusy(DMA_CHANNEL_RX) && delivered < bc.size) {
+                size_t chunk = std::min(FIFO_DEPTH, bc.size - delivered);
+                uart.simulateReceive(src + delivered, chunk);
+                delivered += chunk;
+            }
+        }
+    }
+
+    Sample measure(UARTDriver& uart, UARTDma* dma, const BenchCase& bc) {
+        const uint8_t* src = payload.data();
+        uint8_t* dst = scratch.data();
+        size_t n = bc.size;
+
+        uint64_t c0 = readCycles();
+        Clock::time_point t0 = Clock::now();
+        if (bc.path == PATH_POLLED) {
+            runPolled(uart, bc, src, dst);
+        } else if (bc.path == PATH_DMA) {
+            runDma(uart, *dma, bc, src);
+        } else {
+            switch (bc.op) {
+                case OP_WRITE_BYTE:
+                    for (size_t i = 0; i < n; i++) {
+                        uart.writeByte(src[i]);
+                    }
+                    break;
+                case OP_WRITE_DATA:
+                    uart.writeData(src, n);
+                    break;
+                case OP_READ_BYTE:
+                    for (size_t i = 0; i < n; i++) {
+                        uart.readByte(dst[i]);
+                    }
+                    break;
+                case OP_READ_DATA:
+                    uart.readData(dst, n);
+                    break;
+                case OP_READ_UNTIL: {
+                    size_t length;
+                    uart.readUntil('\n', dst, n, length);
+                    break;
+                }
+                case OP_SIMULATE_RECEIVE:
+                    uart.simulateReceive(src, n);
+                    break;
+                case OP_SIMULATE_TRANSMIT:
+                    uart.simulateTransmit(n);
+                    break;
+            }
+        }
+        Clock::time_point t1 = Clock::now();
+        uint64_t c1 = readCycles();
+
+        Sample sample;
+        sample.ns = std::chrono::duration<double, std::nano>(t1 - t0).count() - overhead.ns;
+        sample.cycles = static_cast<double>(c1 - c0) - overhead.cycles;
+        if (sample.ns < 0.0) {
+            sample.ns = 0.0;
+        }
+        if (sample.cycles < 0.0) {
+            sample.cycles = 0.0;
+        }
+        return sample;
+    }
+
+    static void appendNumber(std::string& json, const char* key, double value, bool comma = true) {
+        char text[96];
+        snprintf(text, sizeof(text), "\"%s\": %.3f%s", key, value, comma ? ", " : "");
+        json += text;
+    }
+
+    static void appendInteger(std::string& json, const char* key, size_t value) {
+        char text[96];
+        snprintf(text, sizeof(text), "\"%s\": %zu, ", key, value);
+        json += text;
+    }
+
+    void append(const BenchCase& bc, const std::vector<Sample>& results, std::string& json, bool& first) {
+        std::vector<double> ns;
+        std::vector<double> cycles;
+        for (size_t i = 0; i < results.size(); i++) {
+            ns.push_back(results[i].ns);
+            cycles.push_back(results[i].cycles);
+        }
+        std::sort(ns.begin(), ns.end());
+        std::sort(cycles.begin(), cycles.end());
+
+        double bytes = static_cast<double>(bc.size);
+        double median = percentile(ns, 0.5);
+
+        json += first ? "\n    {" : ",\n    {";
+        first = false;
+        json += "\"op\": \"";
+        json += operationName(bc.op);
+        json += "\", \"path\": \"";
+        json += pathName(bc.path);
+        json += "\", ";
+        appendInteger(json, "size", bc.size);
+        appendInteger(json, "fill", bc.fill);
+        appendInteger(json, "wrap", bc.wrap);
+        appendInteger(json, "samples", results.size());
+        appendNumber(json, "ns_min", ns.front());
+        appendNumber(json, "ns_median", median);
+        appendNumber(json, "ns_p90", percentile(ns, 0.90));
+        appendNumber(json, "ns_p99", percentile(ns, 0.99));
+        appendNumber(json, "ns_max", ns.back());
+        appendNumber(json, "ns_per_byte", median / bytes);
+        appendNumber(json, "bytes_per_sec", median > 0.0 ? bytes * 1e9 / median : 0.0);
+        if (UART_BENCH_HAVE_TSC) {
+            appendNumber(json, "cycles_per_byte", percentile(cycles, 0.5) / bytes, false);
+        } else {
+            json += "\"cycles_per_byte\": null";
+        }
+        json += "}";
+    }
+};
+
+std::vector<BenchCase> buildCases(bool quick) {
+    const Operation ops[] = {
+        OP_WRITE_BYTE, OP_WRITE_DATA, OP_READ_BYTE,
+        OP_READ_DATA, OP_READ_UNTIL, OP_SIMULATE_RECEIVE, OP_SIMULATE_TRANSMIT
+    };
+    const size_t depth = FIFO_DEPTH;
+
+    std::vector<size_t> sizes;
+    std::vector<size_t> fills;
+    std::vector<size_t> wraps;
+    std::vector<size_t> tier_sizes;
+    if (quick) {
+        sizes.push_back(1);
+        sizes.push_back(depth);
+        fills.push_back(0);
+        wraps.push_back(0);
+        wraps.push_back(depth - 1);
+        tier_sizes.push_back(1024);
+    } else {
+        for (size_t s = 1; s <= depth; s *= 2) {
+            sizes.push_back(s);
+        }
+        for (size_t f = 0; f < depth; f += depth / 4) {
+            fills.push_back(f);
+        }
+        wraps.push_back(0);
+        wraps.push_back(depth / 2);
+        wraps.push_back(depth - 1);
+        for (size_t s = 64; s <= 4096; s *= 4) {
+            tier_sizes.push_back(s);
+        }
+    }
+
+    std::vector<BenchCase> cases;
+    for (size_t o = 0; o < sizeof(ops) / sizeof(ops[0]); o++) {
+        // Hardware FIFO path: every size/fill/wrap combination that fits
+        for (size_t s = 0; s < sizes.size(); s++) {
+            for (size_t f = 0; f < fills.size(); f++) {
+                if (sizes[s] + fills[f] > depth) {
+                    continue;
+                }
+                for (size_t w = 0; w < wraps.size(); w++) {
+                    BenchCase bc = {ops[o], PATH_FIFO, sizes[s], fills[f], wraps[w]};
+                    cases.push_back(bc);
+                }
+            }
+        }
+        // Software tier path: bursts larger than the FIFO
+        for (size_t s = 0; s < tier_sizes.size(); s++) {
+            BenchCase bc = {ops[o], PATH_SOFTWARE_TIER, tier_sizes[s], 0, 0};
+            cases.push_back(bc);
+        }
+        // Polled and DMA paths: the same bursts, device side included
+        if (ops[o] == OP_WRITE_DATA || ops[o] == OP_READ_DATA) {
+            for (size_t s = 0; s < tier_sizes.size(); s++) {
+                BenchCase polled = {ops[o], PATH_POLLED, tier_sizes[s], 0, 0};
+                BenchCase dma = {ops[o], PATH_DMA, tier_sizes[s], 0, 0};
+                cases.push_back(polled);
+                cases.push_back(dma);
+            }
+        }
+    }
+    return cases;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t samples = 0;
+    bool quick = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--samples") == 0 && i + 1 < argc) {
+            samples = static_cast<size_t>(strtoul(argv[++i], nullptr, 10));
+            if (samples == 0) {
+                samples = 1;
+            }
+        } else if (strcmp(argv[i], "--quick") == 0) {
+            quick = true;
+        } else {
+            fprintf(stderr, "usage: %s [--samples N] [--quick]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (samples == 0) {
+        // --quick lowers the default; an explicit --samples always wins
+        samples = quick ? 200 : 2000;
+    }
+
+    TimerOverhead overhead = measureOverhead(samples);
+    Bench bench(samples, overhead);
+    std::vector<BenchCase> cases = buildCases(quick);
+
+    std::string json = "{\n  \"benchmark\": \"uart_bench\",\n";
+    char text[256];
+    snprintf(text, sizeof(text),
+             "  \"fifo_depth\": %zu,\n  \"timer_overhead_ns\": %.3f,\n  \"cycle_counter\": \"%s\",\n"
+             "  \"results\": [",
+             FIFO_DEPTH, overhead.ns, UART_BENCH_HAVE_TSC ? "tsc" : "none");
+    json += text;
+
+    bool first = true;
+    for (size_t i = 0; i < cases.size(); i++) {
+        bench.run(cases[i], json, first);
+    }
+    json += "\n  ]\n}\n";
+
+    fputs(json.c_str(), stdout);
+    return 0;
+}
@@ -0,0 +1,473 @@
+#ifndef UART_ASYNC_H
+#define UART_ASYNC_H
+
+#include "uart_driver.h"
+#include <cstdint>
+#include <cstddef>
+
+// Requires C++20 (configure with -DUART_ENABLE_COROUTINES=ON)
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace uart {
+
+class UARTExecutor;
+
+template <typename T>
+class Task;
+
+namespace detail {
+
+struct TaskPromiseBase {
+    std::coroutine_handle<> continuation;   // Awaiting coroutine, if any
+    UARTExecutor* owner = nullptr;          // Executor of a spawned task
+
+    std::suspend_always initial_suspend() noexcept { return {}; }
+
+    struct FinalAwaiter {
+        bool await_ready() noexcept { return false; }
+
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept;
+
+        void await_resume() noexcept {}
+    };
+
+    FinalAwaiter final_suspend() noexcept { return {}; }
+
+    // Errors are reported through return values in this library
+    void unhandled_exception() { std::terminate(); }
+};
+
+template <typename T>
+struct TaskPromise : TaskPromiseBase {
+    T value{};
+
+    Task<T> get_return_object();
+    void return_value(T result) { value = std::move(result); }
+    T take() { return std::move(value); }
+};
+
+template <>
+struct TaskPromise<void> : TaskPromiseBase {
+    Task<void> get_return_object();
+    void return_void() {}
+    void take() {}
+};
+
+} // namespace detail
+
+/**
+ * @brief Lazily started coroutine returning T
+ *
+ * A Task runs when it is awaited (the awaiting coroutine resumes when it
+ * finishes) or when it is handed to UARTExecutor::spawn().
+ */
+template <typename T>
+class Task {
+public:
+    typedef detail::TaskPromise<T> promise_type;
+
+    Task() : handle(nullptr) {}
+    explicit Task(std::coroutine_handle<promise_type> h) : handle(h) {}
+    Task(Task&& other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            if (handle) {
+                handle.destroy();
+            }
+            handle = std::exchange(other.handle, nullptr);
+        }
+        return *this;
+    }
+
+    ~Task() {
+        if (handle) {
+            handle.destroy();
+        }
+    }
+
+    struct Awaiter {
+        std::coroutine_handle<promise_type> handle;
+
+        bool await_ready() noexcept { return false; }
+
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+            handle.promise().continuation = awaiting;
+            return handle;
+        }
+
+        T await_resume() { return handle.promise().take(); }
+    };
+
+    Awaiter operator co_await() && noexcept { return Awaiter{handle}; }
+
+    /**
+     * @brief Give up ownership of the coroutine frame (used by spawn())
+     */
+    std::coroutine_handle<promise_type> release() { return std::exchange(handle, nullptr); }
+
+private:
+    std::coroutine_handle<promise_type> handle;
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+};
+
+namespace detail {
+
+template <typename T>
+Task<T> TaskPromise<T>::get_return_object() {
+    return Task<T>(std::coroutine_handle<TaskPromise<T> >::from_promise(*this));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() {
+    return Task<void>(std::coroutine_handle<TaskPromise<void> >::from_promise(*this));
+}
+
+} // namespace detail
+
+/**
+ * @brief Coroutines suspended on one port, woken from its interrupt
+ *
+ * waiters is only touched on the executor thread; signaled is set from the
+ * device side.
+ */
+struct AsyncWaitList {
+    std::vector<std::coroutine_handle<> > waiters;
+    std::atomic<bool> signaled{false};
+};
+
+/**
+ * @brief Single-threaded executor for UART coroutines
+ *
+ * Coroutines run only inside run() or poll(), on the calling thread. A
+ * coroutine waiting for a port is parked on that port's wait list and costs
+ * nothing until the port's interrupt handler signals the executor, which may
+ * happen from any thread; the executor then resumes the port's waiters, and
+ * each re-checks its condition. While nothing is runnable, run() sleeps on a
+ * condition variable rather than polling.
+ */
+class UARTExecutor {
+public:
+    UARTExecutor() : live_tasks(0) {}
+
+    UARTExecutor(const UARTExecutor&) = delete;
+    UARTExecutor& operator=(const UARTExecutor&) = delete;
+
+    /**
+     * @brief Start a task; the executor owns it until it finishes
+     */
+    template <typename T>
+    void spawn(Task<T> task) {
+        std::coroutine_handle<detail::TaskPromise<T> > handle = task.release();
+        handle.promise().owner = this;
+        live_tasks++;
+        schedule(handle);
+    }
+
+    /**
+     * @brief Queue a suspended coroutine to be resumed (executor thread)
+     */
+    void schedule(std::coroutine_handle<> handle) { ready.push_back(handle); }
+
+    /**
+     * @brief Wake the waiters of a port; callable from any thread
+     */
+    void signal(AsyncWaitList& list) {
+        if (list.signaled.exchange(true, std::memory_order_acq_rel)) {
+            return;  // Already queued
+        }
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            signaled.push_back(&list);
+        }
+        wakeup.notify_one();
+    }
+
+    /**
+     * @brief Resume everything runnable now, without blocking
+     * @return Coroutines resumed
+     */
+    size_t poll() {
+        collectSignaled();
+        size_t resumed = 0;
+        while (!ready.empty()) {
+            std::vector<std::coroutine_handle<> > batch;
+            batch.swap(ready);
+            for (size_t i = 0; i < batch.size(); i++) {
+                batch[i].resume();
+                resumed++;
+            }
+            collectSignaled();
+        }
+        return resumed;
+    }
+
+    /**
+     * @brief Run until every spawned task has finished
+     */
+    void run() {
+        for (;;) {
+            poll();
+            if (live_tasks == 0) {
+                return;
+            }
+            std::unique_lock<std::mutex> guard(lock);
+            wakeup.wait(guard, [this] { return !signaled.empty(); });
+        }
+    }
+
+    size_t getLiveTasks() const { return live_tasks; }
+
+    /**
+     * @brief Park a coroutine on a port's wait list (executor thread)
+     */
+    void park(AsyncWaitList& list, std::coroutine_handle<> handle) { list.waiters.push_back(handle); }
+
+    /**
+     * @brief Take a coroutine back off a wait list (executor thread)
+     */
+    void unpark(AsyncWaitList& list, std::coroutine_handle<> handle) {
+        for (size_t i = 0; i < list.waiters.size(); i++) {
+            if (list.waiters[i] == handle) {
+                list.waiters[i] = list.waiters.back();
+                list.waiters.pop_back();
+                return;
+            }
+        }
+    }
+
+    /**
+     * @brief Forget a wait list that is about to be destroyed (executor thread)
+     * A pending signal for it is dropped; coroutines still parked on it are
+     * not resumed.
+     */
+    void detach(AsyncWaitList& list) {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            signaled.erase(std::remove(signaled.begin(), signaled.end(), &list), signaled.end());
+        }
+        list.waiters.clear();
+    }
+
+    void taskFinished() { live_tasks--; }
+
+private:
+    std::vector<std::coroutine_handle<> > ready;
+    size_t live_tasks;
+
+    std::mutex lock;
+    std::condition_variable wakeup;
+    std::vector<AsyncWaitList*> signaled;   // Guarded by lock
+
+    void collectSignaled() {
+        std::vector<AsyncWaitList*> lists;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            lists.swap(signaled);
+        }
+        for (size_t i = 0; i < lists.size(); i++) {
+            // Clear before resuming so a new interrupt queues the port again
+            lists[i]->signaled.store(false, std::memory_order_release);
+            ready.insert(ready.end(), lists[i]->waiters.begin(), lists[i]->waiters.end());
+            lists[i]->waiters.clear();
+        }
+    }
+};
+
+namespace detail {
+
+template <typename Promise>
+std::coroutine_handle<> TaskPromiseBase::FinalAwaiter::await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+    TaskPromiseBase& promise = handle.promise();
+    if (promise.continuation) {
+        return promise.continuation;
+    }
+    if (promise.owner) {
+        UARTExecutor* owner = promise.owner;
+        handle.destroy();
+        owner->taskFinished();
+    }
+    return std::noop_coroutine();
+}
+
+} // namespace detail
+
+/**
+ * @brief Awaitable read and write operations on one driver
+ *
+ * The port's interrupt handler is taken over: RX trigger at one byte and TX
+ * low water at three quarters, each signaling the executor. Operations loop
+ * over the driver's nonblocking calls and suspend only when no progress is
+ * possible, so any number of transfers can be in flight on one thread.
+ * close() ends all pending and future operations with their partial counts.
+ *
+ * Operations run on the executor thread (the application side); the device
+ * side may run on any thread. Destroy the port only with no operation
+ * pending; a signal it still has queued is withdrawn from the executor.
+ */
+template <typename Driver>
+class BasicAsyncUART {
+public:
+    BasicAsyncUART(UARTExecutor& executor, Driver& uart)
+        : executor(executor)
+        , uart(uart)
+        , closed(false) {
+        uart.setInterruptHandler(&BasicAsyncUART::onInterrupt, this);
+        uart.configureInterrupts(INT_RX_TRIGGER | INT_TX_LOW | INT_LINE_ERROR, FCR_RX_TRIG_1 | FCR_TX_LOW_3QUARTER);
+    }
+
+    ~BasicAsyncUART() {
+        uart.setInterruptHandler(nullptr, nullptr);
+        executor.detach(waits);
+    }
+
+    Driver& driver() { return uart; }
+
+    /**
+     * @brief Read exactly length bytes
+     * @return Bytes read (less than length only after close())
+     */
+    Task<size_t> readAsync(uint8_t* buffer, size_t length) {
+        size_t done = 0;
+        while (done < length) {
+            size_t n = uart.readData(buffer + done, length - done);
+            done += n;
+            if (n == 0 && !co_await waitFor(WAIT_READABLE)) {
+                break;
+            }
+        }
+        co_return done;
+    }
+
+    /**
+     * @brief Queue all length bytes for transmission
+     * @return Bytes queued (less than length only after close())
+     */
+    Task<size_t> writeAsync(const uint8_t* data, size_t length) {
+        size_t done = 0;
+        while (done < length) {
+            size_t n = uart.writeData(data + done, length - done);
+            done += n;
+            if (n == 0 && !co_await waitFor(WAIT_WRITABLE)) {
+                break;
+            }
+        }
+        co_return done;
+    }
+
+    /**
+     * @brief Read one delimited record (see BasicUARTDriver::readUntil)
+     * @return Bytes read; the delimiter was found if the last one is it
+     * Suspends while only part of a record is queued, leaving it in the
+     * receiver until more data arrives. An overlong record is returned in
+     * max_length byte pieces; one that fills the receiver is taken into
+     * buffer so the line keeps flowing. A partial record is returned only
+     * after close().
+     */
+    Task<size_t> readUntil(uint8_t delimiter, uint8_t* buffer, size_t max_length) {
+        size_t done = 0;
+        while (done < max_length) {
+            size_t length = 0;
+            bool found = uart.readUntil(delimiter, buffer + done, max_length - done, length);
+            done += length;
+            if (found || length > 0) {
+                break;
+            }
+            size_t queued = queuedRx();
+            if (queued > 0 && uart.getRxSpace() == 0) {
+                done += uart.readData(buffer + done, max_length - done);
+                continue;
+            }
+            if (!co_await waitFor(WAIT_MORE_DATA, queued)) {
+                break;
+            }
+        }
+        co_return done;
+    }
+
+    /**
+     * @brief End every pending and future operation
+     */
+    void close() {
+        closed = true;
+        executor.signal(waits);
+    }
+
+    bool isClosed() const { return closed; }
+
+private:
+    enum WaitKind {
+        WAIT_READABLE,
+        WAIT_WRITABLE,
+        WAIT_MORE_DATA      // More than seen bytes queued for reading
+    };
+
+    // Suspends until the condition holds; false once the port is closed
+    struct WaitAwaiter {
+        BasicAsyncUART* port;
+        WaitKind kind;
+        size_t seen;
+
+        bool await_ready() { return port->closed || port->isReady(kind, seen); }
+
+        bool await_suspend(std::coroutine_handle<> handle) {
+            port->executor.park(port->waits, handle);
+            // An interrupt before parking was missed; re-check with the
+            // coroutine parked so one arriving now is not
+            if (port->closed || port->isReady(kind, seen)) {
+                port->executor.unpark(port->waits, handle);
+                return false;
+            }
+            return true;
+        }
+
+        bool await_resume() { return !port->closed; }
+    };
+
+    UARTExecutor& executor;
+    Driver& uart;
+    AsyncWaitList waits;
+    bool closed;
+
+    WaitAwaiter waitFor(WaitKind kind, size_t seen = 0) { return WaitAwaiter{this, kind, seen}; }
+
+    bool isReady(WaitKind kind, size_t seen) {
+        switch (kind) {
+            case WAIT_READABLE:  return uart.hasData();
+            case WAIT_WRITABLE:  return uart.canTransmit();
+            default:             return queuedRx() > seen;
+        }
+    }
+
+    size_t queuedRx() {
+        ConstByteRegions regions = uart.peekRx();
+        return regions.first.size + regions.second.size;
+    }
+
+    static void onInterrupt(uint32_t, void* context) {
+        BasicAsyncUART* port = static_cast<BasicAsyncUART*>(context);
+        port->executor.signal(port->waits);
+    }
+
+    BasicAsyncUART(const BasicAsyncUART&) = delete;
+    BasicAsyncUART& operator=(const BasicAsyncUART&) = delete;
+};
+
+typedef BasicAsyncUART<UARTDriver> AsyncUART;
+
+} // namespace uart
+
+#endif // __cpp_impl_coroutine
+
+#endif // UART_ASYNC_H
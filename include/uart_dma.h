@@ -0,0 +1,307 @@
+#ifndef UART_DMA_H
+#define UART_DMA_H
+
+#include "uart_driver.h"
+#include <cstdint>
+#include <cstddef>
+
+namespace uart {
+
+/**
+ * @brief Scatter-gather DMA descriptor
+ *
+ * Descriptors are chained through next. A chain that links back to its first
+ * descriptor runs in circular mode and never completes on its own; one that
+ * loops back to any later descriptor is rejected. The DMA engine updates
+ * transferred and done; the caller owns the memory.
+ */
+struct DmaDescriptor {
+    uint8_t* buffer;       // TX source or RX destination
+    size_t length;         // Bytes to transfer
+    DmaDescriptor* next;   // Next descriptor, or nullptr to end the chain
+    size_t transferred;    // Bytes moved so far (written by DMA)
+    bool done;             // Descriptor finished (written by DMA)
+};
+
+enum DmaChannelId {
+    DMA_CHANNEL_TX = 0,
+    DMA_CHANNEL_RX = 1
+};
+
+// DMA channel events
+constexpr uint32_t DMA_EVENT_DESCRIPTOR = (1 << 0);  // One descriptor finished
+constexpr uint32_t DMA_EVENT_HALF       = (1 << 1);  // Half of the chain transferred
+constexpr uint32_t DMA_EVENT_COMPLETE   = (1 << 2);  // Whole chain (or one circular pass) transferred
+
+/**
+ * @brief Per-channel DMA counters
+ */
+struct DmaChannelStats {
+    uint64_t bytes;       // Bytes moved between FIFO and memory
+    uint64_t requests;    // Request-line activations serviced
+    uint64_t chains;      // Chains (or circular passes) completed
+};
+
+/**
+ * @brief DMA controller attached to a UART's request lines
+ *
+ * The TX channel feeds the TX FIFO from descriptor buffers whenever the
+ * driver raises DMA_REQ_TX; the RX channel drains the RX FIFO into
+ * descriptor buffers on DMA_REQ_RX. Both run from the device side with no
+ * per-chunk application calls. While a channel is active the controller is
+ * that direction's application side, so the application must not read
+ * (RX) or write (TX) the driver directly.
+ *
+ * Completion is reported through the latched status and an optional
+ * callback, which may start a new chain on the same channel.
+ */
+template <typename Driver>
+class BasicUARTDma {
+public:
+    typedef void (*DmaCallback)(DmaChannelId channel, uint32_t events, void* context);
+
+    explicit BasicUARTDma(Driver& driver)
+        : uart(driver)
+        , callback(nullptr)
+        , callback_context(nullptr) {
+        clearChannel(channels[DMA_CHANNEL_TX]);
+        clearChannel(channels[DMA_CHANNEL_RX]);
+        uart.setDmaRequestHandler(&BasicUARTDma::onRequest, this);
+    }
+
+    ~BasicUARTDma() {
+        uart.setDmaRequestHandler(nullptr, nullptr);
+    }
+
+    void setCallback(DmaCallback handler, void* context) {
+        callback = handler;
+        callback_context = context;
+    }
+
+    /**
+     * @brief Start transmitting a descriptor chain
+     * @return false if the channel is busy or the chain is empty or malformed
+     */
+    bool startTx(DmaDescriptor* chain) {
+        if (!start(channels[DMA_CHANNEL_TX], chain)) {
+            return false;
+        }
+        // Prime the FIFO immediately, as the hardware would on enable
+        serviceTx();
+        return true;
+    }
+
+    /**
+     * @brief Start receiving into a descriptor chain
+     * @return false if the channel is busy or the chain is empty or malformed
+     */
+    bool startRx(DmaDescriptor* chain) {
+        if (!start(channels[DMA_CHANNEL_RX], chain)) {
+            return false;
+        }
+        serviceRx();
+        return true;
+    }
+
+    /**
+     * @brief Stop a channel; descriptors keep their progress
+     */
+    void abort(DmaChannelId channel) {
+        channels[channel].current = nullptr;
+    }
+
+    bool isBusy(DmaChannelId channel) const {
+        return channels[channel].current != nullptr;
+    }
+
+    /**
+     * @brief Latched DMA_EVENT_* bits for a channel
+     */
+    uint32_t getStatus(DmaChannelId channel) const {
+        return channels[channel].status;
+    }
+
+    void clearStatus(DmaChannelId channel, uint32_t events) {
+        channels[channel].status &= ~events;
+    }
+
+    /**
+     * @brief Bytes moved in the current chain pass
+     */
+    size_t getTransferred(DmaChannelId channel) const {
+        return channels[channel].pass_bytes;
+    }
+
+    const DmaChannelStats& getStats(DmaChannelId channel) const {
+        return channels[channel].stats;
+    }
+
+private:
+    struct Channel {
+        DmaDescriptor* head;
+        DmaDescriptor* current;
+        size_t pass_total;     // Bytes in one pass over the chain
+        size_t pass_bytes;     // Bytes moved in the current pass
+        bool half_signalled;
+        uint32_t status;
+        DmaChannelStats stats;
+    };
+
+    Driver& uart;
+    Channel channels[2];
+    DmaCallback callback;
+    void* callback_context;
+
+    static void clearChannel(Channel& channel) {
+        channel.head = nullptr;
+        channel.current = nullptr;
+        channel.pass_total = 0;
+        channel.pass_bytes = 0;
+        channel.half_signalled = false;
+        channel.status = 0;
+        channel.stats.bytes = 0;
+        channel.stats.requests = 0;
+        channel.stats.chains = 0;
+    }
+
+    static void resetDescriptors(DmaDescriptor* head) {
+        DmaDescriptor* desc = head;
+        do {
+            desc->transferred = 0;
+            desc->done = false;
+            desc = desc->next;
+        } while (desc && desc != head);
+    }
+
+    // True if the chain ends in nullptr or links back to head. A loop into a
+    // later descriptor never returns to head, so walking it would not end.
+    static bool wellFormed(DmaDescriptor* head) {
+        // Floyd's tortoise and hare: the hare reaches nullptr or meets the
+        // tortoise on the loop within a bounded number of steps
+        DmaDescriptor* slow = head;
+        DmaDescriptor* fast = head;
+        for (;;) {
+            if (!fast->next || !fast->next->next) {
+                return true;
+            }
+            slow = slow->next;
+            fast = fast->next->next;
+            if (slow == fast) {
+                break;
+            }
+        }
+        DmaDescriptor* desc = slow;
+        do {
+            if (desc == head) {
+                return true;
+            }
+            desc = desc->next;
+        } while (desc != slow);
+        return false;
+    }
+
+    bool start(Channel& channel, DmaDescriptor* chain) {
+        if (channel.current || !chain || !wellFormed(chain)) {
+            return false;
+        }
+        size_t total = 0;
+        DmaDescriptor* desc = chain;
+        do {
+            total += desc->length;
+            desc = desc->next;
+        } while (desc && desc != chain);
+        if (total == 0) {
+            return false;
+        }
+
+        resetDescriptors(chain);
+        channel.head = chain;
+        channel.current = chain;
+        channel.pass_total = total;
+        channel.pass_bytes = 0;
+        channel.half_signalled = false;
+        return true;
+    }
+
+    static void onRequest(uint32_t requests, void* context) {
+        BasicUARTDma* dma = static_cast<BasicUARTDma*>(context);
+        if (requests & DMA_REQ_RX) {
+            dma->channels[DMA_CHANNEL_RX].stats.requests++;
+            dma->serviceRx();
+        }
+        if (requests & DMA_REQ_TX) {
+            dma->channels[DMA_CHANNEL_TX].stats.requests++;
+            dma->serviceTx();
+        }
+    }
+
+    void serviceTx() {
+        Channel& channel = channels[DMA_CHANNEL_TX];
+        while (channel.current) {
+            DmaDescriptor* desc = channel.current;
+            size_t moved = uart.writeData(desc->buffer + desc->transferred, desc->length - desc->transferred);
+            if (!advance(DMA_CHANNEL_TX, moved) && moved == 0) {
+                break;
+            }
+        }
+    }
+
+    void serviceRx() {
+        Channel& channel = channels[DMA_CHANNEL_RX];
+        while (channel.current) {
+            DmaDescriptor* desc = channel.current;
+            size_t moved = uart.readData(desc->buffer + desc->transferred, desc->length - desc->transferred);
+            if (!advance(DMA_CHANNEL_RX, moved) && moved == 0) {
+                break;
+            }
+        }
+    }
+
+    // Account for moved bytes; true if the channel moved to a new descriptor
+    bool advance(DmaChannelId id, size_t moved) {
+        Channel& channel = channels[id];
+        DmaDescriptor* desc = channel.current;
+        desc->transferred += moved;
+        channel.pass_bytes += moved;
+        channel.stats.bytes += moved;
+
+        uint32_t events = 0;
+        if (!channel.half_signalled && channel.pass_bytes * 2 >= channel.pass_total) {
+            channel.half_signalled = true;
+            events |= DMA_EVENT_HALF;
+        }
+
+        bool next_descriptor = false;
+        if (desc->transferred == desc->length) {
+            desc->done = true;
+            events |= DMA_EVENT_DESCRIPTOR;
+            next_descriptor = true;
+            channel.current = desc->next;
+
+            if (!desc->next || desc->next == channel.head) {
+                events |= DMA_EVENT_COMPLETE;
+                channel.stats.chains++;
+                channel.pass_bytes = 0;
+                channel.half_signalled = false;
+                if (desc->next) {
+                    // Circular mode: start the next pass
+                    resetDescriptors(channel.head);
+                }
+            }
+        }
+
+        if (events) {
+            channel.status |= events;
+            if (callback) {
+                callback(id, events, callback_context);
+            }
+        }
+        return next_descriptor;
+    }
+};
+
+typedef BasicUARTDma<UARTDriver> UARTDma;
+
+} // namespace uart
+
+#endif // UART_DMA_H
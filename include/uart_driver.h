@@ -1,31 +1,194 @@
 #ifndef UART_DRIVER_H
 #define UART_DRIVER_H
 
+#include "uart_mapped_registers.h"
+#include "uart_parity.h"
 #include "uart_registers.h"
+#include "uart_spsc_ring.h"
+#include "uart_stats.h"
+#include <atomic>
 #include <cstdint>
 #include <cstddef>
+#include <cstring>
 
 namespace uart {
 
+// Trace events (see BasicUARTDriver::setTraceHook)
+constexpr uint32_t TRACE_RX       = 1;  // simulateReceive: bytes offered by the line
+constexpr uint32_t TRACE_TX_WRITE = 2;  // writeByte/writeData/commitTx: bytes offered by the application
+constexpr uint32_t TRACE_TX_DONE  = 3;  // simulateTransmit/drainTx: characters sent, if any
+
+/**
+ * @brief TX and RX rings of one port
+ *
+ * The rings hold no pointers, so the pair can be placed in memory that other
+ * processes map at a different address.
+ */
+template <size_t TxDepth, size_t RxDepth>
+struct SPSCRingPair {
+    SPSCRing<TxDepth> tx;
+    SPSCRing<RxDepth> rx;
+};
+
+/**
+ * @brief FIFO placement with the rings stored in the driver (the default)
+ */
+template <size_t TxDepth, size_t RxDepth>
+class InlineFifos {
+public:
+    static constexpr bool OWNED = true;
+
+    SPSCRing<TxDepth>& tx() { return rings.tx; }
+    const SPSCRing<TxDepth>& tx() const { return rings.tx; }
+    SPSCRing<RxDepth>& rx() { return rings.rx; }
+    const SPSCRing<RxDepth>& rx() const { return rings.rx; }
+
+private:
+    SPSCRingPair<TxDepth, RxDepth> rings;
+};
+
+/**
+ * @brief FIFO placement with the rings in caller memory, e.g. shared memory
+ */
+template <size_t TxDepth, size_t RxDepth>
+class MappedFifos {
+public:
+    static constexpr bool OWNED = false;
+
+    explicit MappedFifos(SPSCRingPair<TxDepth, RxDepth>* pair)
+        : rings(pair) {
+    }
+
+    SPSCRing<TxDepth>& tx() { return rings->tx; }
+    const SPSCRing<TxDepth>& tx() const { return rings->tx; }
+    SPSCRing<RxDepth>& rx() { return rings->rx; }
+    const SPSCRing<RxDepth>& rx() const { return rings->rx; }
+
+private:
+    SPSCRingPair<TxDepth, RxDepth>* rings;
+};
+
+template <size_t TxDepth, size_t RxDepth>
+constexpr bool InlineFifos<TxDepth, RxDepth>::OWNED;
+
+template <size_t TxDepth, size_t RxDepth>
+constexpr bool MappedFifos<TxDepth, RxDepth>::OWNED;
+
+/**
+ * @brief Configuration for the optional software buffer tier
+ *
+ * A capacity of 0 leaves that direction without a software buffer. Heap
+ * capacities are rounded up to a power of two; caller-provided memory must
+ * already be a power of two in size. A watermark of 0 selects the default
+ * (TX refill at 1/4 full, RX drain at 3/4 full).
+ */
+struct SoftwareBufferConfig {
+    SoftwareBufferConfig()
+        : tx_capacity(64 * 1024)
+        , rx_capacity(64 * 1024)
+        , tx_memory(nullptr)
+        , rx_memory(nullptr)
+        , tx_low_watermark(0)
+        , rx_high_watermark(0) {
+    }
+    
+    size_t tx_capacity;        // Software TX buffer size in bytes
+    size_t rx_capacity;        // Software RX buffer size in bytes
+    uint8_t* tx_memory;        // Caller-owned TX storage, or nullptr for heap
+    uint8_t* rx_memory;        // Caller-owned RX storage, or nullptr for heap
+    size_t tx_low_watermark;   // Refill hardware TX FIFO at or below this level
+    size_t rx_high_watermark;  // Drain hardware RX FIFO at or above this level
+};
+
 /**
  * @brief UART driver for simulated hardware peripheral
  * 
  * This driver provides an interface to a simulated UART hardware block.
  * It includes TX/RX FIFOs and handles typical UART operations.
+ *
+ * Threading: the TX and RX FIFOs are wait-free SPSC rings, so the driver can
+ * run with one application thread (writeByte/writeData/readByte/readData) and
+ * one device thread (simulateReceive/simulateTransmit) concurrently without
+ * locks. initialize() and shutdown() require both sides to be idle.
+ *
+ * FIFO depths are compile-time parameters and must be powers of two, so each
+ * variant carries only the storage it needs and wraps indices with a mask.
+ *
+ * An optional software buffer tier (attachSoftwareBuffers) sits behind the
+ * hardware FIFOs. The application then reads and writes the large software
+ * rings, and the device side moves data between them and the hardware FIFOs
+ * at the configured watermarks, so bursts larger than the FIFO survive.
+ *
+ * Interrupts: configureInterrupts() selects an RX trigger level and a TX
+ * low-water level, and the device side calls the registered handler when an
+ * enabled condition fires, so consumers need not poll hasData().
+ *
+ * Parity: with parity enabled, drainTx() generates a parity bit per
+ * character and the parity-aware simulateReceive() checks them in bulk,
+ * latching STATUS_FRAME_ERR and INT_LINE_ERROR on a mismatch.
+ *
+ * Statistics: every port keeps relaxed single-writer counters (traffic,
+ * overruns, frame errors, TX rejections, high-water marks and an RX
+ * occupancy histogram); getStats() takes a snapshot from any thread.
+ *
+ * Flow control: with CTRL_RTSCTS or CTRL_XONXOFF (configureFlowControl),
+ * the receive path throttles the peer once the RX level reaches a stop
+ * threshold, by dropping RTS or queueing XOFF ahead of TX data, and releases
+ * it at a resume threshold as the application reads. The transmit path
+ * stops while CTS is deasserted or an XOFF is in effect; received XON/XOFF
+ * characters are consumed rather than delivered.
+ *
+ * Tracing: an optional trace hook sees every writeByte/writeData,
+ * simulateReceive and transmit call with its payload (see uart_trace.h).
+ *
+ * Register backend: Registers is the register model the driver talks to,
+ * chosen at compile time. The default is the simulated UARTRegisters;
+ * MappedUARTRegisters puts the registers in a raw volatile block such as a
+ * co-simulation window. Backends share a member-function interface rather
+ * than a base class, so register accesses are direct calls.
+ *
+ * FIFO placement: Fifos decides where the two rings live, also at compile
+ * time. InlineFifos keeps them in the driver; MappedFifos uses an
+ * SPSCRingPair in caller memory, so two drivers in different processes can
+ * share one port (see uart_shm.h). Everything else, including flow control,
+ * the software tier, statistics and callbacks, belongs to each driver object.
+ * A driver over mapped FIFOs does not shut the port down when destroyed.
  */
-class UARTDriver {
+template <size_t TxDepth, size_t RxDepth, typename Registers = UARTRegisters,
+          typename Fifos = InlineFifos<TxDepth, RxDepth> >
+class BasicUARTDriver : public CacheLineAligned {
 public:
-    UARTDriver();
-    ~UARTDriver();
+    static constexpr size_t TX_FIFO_DEPTH = TxDepth;
+    static constexpr size_t RX_FIFO_DEPTH = RxDepth;
+    
+    BasicUARTDriver();
+    
+    /**
+     * @brief Construct the register backend from an argument
+     * e.g. the register block pointer for MappedUARTRegisters
+     */
+    template <typename BackendArg>
+    explicit BasicUARTDriver(BackendArg backend_arg);
+    
+    /**
+     * @brief Construct the register backend and the FIFO placement
+     * e.g. a register block and an SPSCRingPair pointer for MappedFifos
+     */
+    template <typename BackendArg, typename FifoArg>
+    BasicUARTDriver(BackendArg backend_arg, FifoArg fifo_arg);
+    
+    ~BasicUARTDriver();
     
     /**
      * @brief Initialize the UART with specified configuration
      * @param baud_rate Baud rate divisor
      * @param enable_parity Enable parity checking
      * @param odd_parity Use odd parity (true) or even parity (false)
+     * @param two_stop_bits Use two stop bits (true) or one (false)
      * @return true if initialization successful
      */
-    bool initialize(uint32_t baud_rate, bool enable_parity = false, bool odd_parity = false);
+    bool initialize(uint32_t baud_rate, bool enable_parity = false, bool odd_parity = false,
+                    bool two_stop_bits = false);
     
     /**
      * @brief Shutdown the UART
@@ -62,6 +225,58 @@ public:
      */
     size_t readData(uint8_t* buffer, size_t max_length);
     
+    /**
+     * @brief Expose received bytes in place (zero-copy read)
+     * @return Up to two contiguous read-only regions; empty if RX disabled
+     * The regions stay valid until consumeRx() releases them.
+     */
+    ConstByteRegions peekRx();
+    
+    /**
+     * @brief Release bytes returned by peekRx()
+     * @return Number of bytes released
+     */
+    size_t consumeRx(size_t num_bytes);
+    
+    /**
+     * @brief Read one delimited record, up to and including the delimiter
+     * @param delimiter Terminating byte
+     * @param buffer Destination buffer
+     * @param max_length Capacity of buffer
+     * @param length Set to the number of bytes copied
+     * @return true if the delimiter was found (it is the last byte copied)
+     * Both ring segments are searched with memchr. Without a delimiter the
+     * partial record stays queued and nothing is copied, unless it already
+     * fills max_length bytes; that much is then read so an overlong record
+     * cannot block the receiver.
+     */
+    bool readUntil(uint8_t delimiter, uint8_t* buffer, size_t max_length, size_t& length);
+    
+    /**
+     * @brief Read one '\n'-terminated line as a C string
+     * @param line Destination, NUL-terminated on return
+     * @param max_length Capacity of line including the terminating NUL
+     * @param length Set to the string length, without the line ending
+     * @return true if a complete line was read
+     * The "\n" or "\r\n" ending is stripped. An overlong line is returned in
+     * max_length - 1 byte pieces with false, as with readUntil().
+     */
+    bool readLine(char* line, size_t max_length, size_t& length);
+    
+    /**
+     * @brief Expose TX space for in-place writes (zero-copy write)
+     * @param max_length Maximum number of bytes wanted
+     * @return Up to two contiguous writable regions; empty if TX disabled
+     */
+    ByteRegions reserveTx(size_t max_length);
+    
+    /**
+     * @brief Queue bytes written into regions returned by reserveTx()
+     * @param num_bytes Bytes written; must not exceed the reserved size
+     * @return Bytes queued; num_bytes clamped to the free TX space
+     */
+    size_t commitTx(size_t num_bytes);
+    
     /**
      * @brief Check if TX FIFO has space
      * @return true if TX FIFO can accept more data
@@ -95,41 +310,1265 @@ public:
      */
     void clearErrors();
     
+    /**
+     * @brief Read the status register
+     * FIFO bits are derived from the current FIFO counts; error bits are sticky
+     */
+    uint32_t readStatus() const;
+    
+    /**
+     * @brief Read the control register (CTRL_* configuration bits)
+     */
+    uint32_t readControl() const;
+    
     /**
      * @brief Simulate receiving data (for testing)
      * This simulates data arriving from the external device
+     * @return Bytes accepted and bytes dropped
+     */
+    ReceiveResult simulateReceive(const uint8_t* data, size_t length);
+    
+    /**
+     * @brief Simulate receiving characters with their parity bits
+     * @param parity_bits Received parity bits, packed LSB first (see uart_parity.h)
+     * @param error_mask Optional output: a bit set for each character whose
+     *                   parity check failed; parityMaskBytes(length) bytes
+     * Characters that fail the check are still delivered, as on hardware.
+     * Errors are reported only for characters that reach the RX FIFO: bytes
+     * lost to overrun and XON/XOFF characters never raise STATUS_FRAME_ERR
+     * and their error_mask bits are clear.
+     * Without parity enabled this behaves like simulateReceive(data, length).
      */
-    void simulateReceive(const uint8_t* data, size_t length);
+    ReceiveResult simulateReceive(const uint8_t* data, size_t length, const uint8_t* parity_bits,
+                                  uint8_t* error_mask = nullptr);
     
     /**
      * @brief Simulate transmission completion (for testing)
-     * This moves data from TX FIFO to simulate actual transmission
+     * This moves data from TX FIFO to simulate actual transmission; the
+     * bytes go to the TX sink if one is set, and are discarded otherwise.
+     * @return Number of characters transmitted, including any XON/XOFF
+     */
+    size_t simulateTransmit(size_t num_bytes);
+    
+    /**
+     * @brief Transmit up to max_length characters and return them
+     * @param out Receives the characters in line order
+     * @param parity_bits Optional output for the generated parity bits,
+     *                    parityMaskBytes(max_length) bytes; left untouched if
+     *                    parity is disabled
+     * @return Number of characters transmitted
+     * Device side; equivalent to simulateTransmit() but keeps the data.
+     * The TX sink is not called.
+     */
+    size_t drainTx(uint8_t* out, size_t max_length, uint8_t* parity_bits = nullptr);
+    
+    /**
+     * @brief Transmit sink callback
+     * @param data Transmitted bytes in line order: first, then second
+     * @param context User pointer given to setTxSink
+     * The spans point into the TX FIFO and are valid only during the call.
+     */
+    typedef void (*TxSink)(const ConstByteRegions& data, void* context);
+    
+    /**
+     * @brief Receive the bytes simulateTransmit() sends (nullptr to remove)
+     * Called from the device side. Without the software tier each
+     * simulateTransmit() makes at most one call; with it, one call per FIFO
+     * refill. An XON/XOFF character goes in a call of its own, ahead of data.
+     */
+    void setTxSink(TxSink sink, void* context);
+    
+    /**
+     * @brief Attach software TX/RX buffers behind the hardware FIFOs
+     * Both sides must be idle. Data already queued is discarded.
+     * @return false if caller-provided memory is not a power of two in size
+     */
+    bool attachSoftwareBuffers(const SoftwareBufferConfig& config);
+    
+    /**
+     * @brief Remove the software buffers and release any heap storage
+     */
+    void detachSoftwareBuffers();
+    
+    /**
+     * @brief Move data between the software buffers and the hardware FIFOs
+     * Device side. Called automatically by simulateReceive/simulateTransmit.
+     * Also raises pending DMA requests.
+     */
+    void serviceSoftwareBuffers();
+    
+    /**
+     * @brief Get number of bytes waiting in the software TX buffer
+     */
+    size_t getTxBufferCount() const;
+    
+    /**
+     * @brief Get number of bytes waiting in the software RX buffer
+     */
+    size_t getRxBufferCount() const;
+    
+    /**
+     * @brief Bytes the receive path can accept before overrunning
+     * Counts the RX FIFO and, if attached, the software RX buffer.
+     */
+    size_t getRxSpace() const;
+    
+    /**
+     * @brief Bits on the wire per character: start + 8 data + parity + stop
+     */
+    uint32_t getBitsPerCharacter() const;
+    
+    /**
+     * @brief Time to shift one character at the configured baud rate
+     * @return Nanoseconds per character (rounded), or 0 if no baud rate is set
+     */
+    uint64_t getCharacterTimeNs() const;
+    
+    /**
+     * @brief Interrupt service routine callback
+     * @param pending Enabled INT_* bits that fired
+     * @param context User pointer given to setInterruptHandler
      */
-    void simulateTransmit(size_t num_bytes);
+    typedef void (*InterruptHandler)(uint32_t pending, void* context);
+    
+    /**
+     * @brief Register the interrupt handler (nullptr to remove)
+     * Called from the device side (simulateReceive/simulateTransmit), so the
+     * handler acts as the application side while it runs.
+     */
+    void setInterruptHandler(InterruptHandler handler, void* context);
+    
+    /**
+     * @brief Program interrupt enables and FIFO trigger levels
+     * @param enable_mask INT_* bits to enable
+     * @param fifo_control FCR_RX_TRIG_* | FCR_TX_LOW_* selection
+     * Call after initialize(), which resets the registers.
+     */
+    void configureInterrupts(uint32_t enable_mask, uint32_t fifo_control);
+    
+    /**
+     * @brief Get latched INT_* bits (set even when not enabled)
+     */
+    uint32_t getPendingInterrupts() const;
+    
+    /**
+     * @brief Clear latched interrupt bits (W1C)
+     */
+    void clearInterrupts(uint32_t mask);
+    
+    /**
+     * @brief RX level, in bytes, at which INT_RX_TRIGGER fires
+     */
+    size_t getRxTriggerLevel() const;
+    
+    /**
+     * @brief TX level, in bytes, at which INT_TX_LOW fires
+     */
+    size_t getTxLowWaterLevel() const;
+    
+    /**
+     * @brief Select flow control and the RX thresholds it works at
+     * @param mode 0, CTRL_RTSCTS or CTRL_XONXOFF
+     * @param stop_level RX level (FIFO plus software buffer) at which the
+     *                   peer is paused; 0 = three quarters full
+     * @param resume_level RX level at or below which the peer is resumed;
+     *                     0 = one quarter full
+     * @return false if the levels do not satisfy resume < stop <= capacity
+     * Enabling CTRL_RTSCTS asserts STATUS_CTS until setCts() changes it.
+     * Call after initialize() and attachSoftwareBuffers(); both sides idle.
+     */
+    bool configureFlowControl(uint32_t mode, size_t stop_level = 0, size_t resume_level = 0);
+    
+    /**
+     * @brief Drive the CTS input from the peer's RTS output (device side)
+     */
+    void setCts(bool asserted);
+    
+    /**
+     * @brief Our RTS output: false while the receive path is throttled
+     */
+    bool isRtsAsserted() const;
+    
+    /**
+     * @brief Whether the peer has paused our transmitter (CTS low or XOFF)
+     */
+    bool isTxPaused() const;
+    
+    /**
+     * @brief Whether an XON/XOFF announcement is waiting to be transmitted
+     * Device side. The character goes out ahead of data on the next
+     * transmit, even while the transmitter is paused.
+     */
+    bool isFlowCharPending() const;
+    
+    /**
+     * @brief DMA request line callback
+     * @param requests DMA_REQ_TX (TX FIFO wants data) and/or DMA_REQ_RX (RX data ready)
+     */
+    typedef void (*DmaRequestHandler)(uint32_t requests, void* context);
+    
+    /**
+     * @brief Connect a DMA controller to the request lines (nullptr to remove)
+     * Requests are raised from the device side at the software buffer
+     * watermarks; the controller then acts as the application side.
+     */
+    void setDmaRequestHandler(DmaRequestHandler handler, void* context);
+    
+    /**
+     * @brief Snapshot of the port counters; safe from any thread
+     * Counters survive initialize() and are cleared only by resetStats().
+     */
+    PortStats getStats() const;
+    
+    /**
+     * @brief Zero the port counters; both sides must be idle
+     */
+    void resetStats();
+    
+    /**
+     * @brief Trace callback
+     * @param event TRACE_* event type
+     * @param data Payload for TRACE_RX and TRACE_TX_WRITE, nullptr otherwise
+     * @param length Bytes offered (RX, TX write) or sent (TX done)
+     */
+    typedef void (*TraceHook)(uint32_t event, const uint8_t* data, size_t length, void* context);
+    
+    /**
+     * @brief Register a trace hook (nullptr to remove); both sides must be idle
+     * The hook is called from the application side for writes and from the
+     * device side for receive and transmit, so it must be thread-safe.
+     */
+    void setTraceHook(TraceHook hook, void* context);
     
 private:
-    UARTRegisters registers;
+    Registers registers;
+    
+    // TX FIFO: produced by the application, consumed by the device
+    // RX FIFO: produced by the device, consumed by the application
+    Fifos fifos;
+    
+    // Optional software tier: TX app->device, RX device->app
+    SPSCBuffer tx_buffer;
+    SPSCBuffer rx_buffer;
+    size_t tx_low_watermark;
+    size_t rx_high_watermark;
+    
+    InterruptHandler interrupt_handler;
+    void* interrupt_context;
+    
+    DmaRequestHandler dma_handler;
+    void* dma_context;
+    
+    PortCounters counters;
+    
+    TraceHook trace_hook;
+    void* trace_context;
     
-    // TX FIFO
-    uint8_t tx_fifo[FIFO_DEPTH];
-    size_t tx_head;
-    size_t tx_tail;
-    size_t tx_count;
+    TxSink tx_sink;
+    void* tx_sink_context;
     
-    // RX FIFO
-    uint8_t rx_fifo[FIFO_DEPTH];
-    size_t rx_head;
-    size_t rx_tail;
-    size_t rx_count;
+    // Flow control: mode and levels change only while both sides are idle
+    uint32_t flow_mode;
+    size_t rx_stop_level;
+    size_t rx_resume_level;
+    std::atomic<bool> rx_throttled;   // Peer asked to pause (both sides write)
+    std::atomic<bool> xoff_received;  // Device side writes
+    bool xoff_sent;                   // Device side: state last announced to the peer
     
     // Helper functions
-    void updateStatusFlags();
+    static uint32_t fifoStatus(const void* context);
+    bool txBuffered() const;
+    bool rxBuffered() const;
+    bool txServiced() const;
+    bool rxServiced() const;
+    size_t receiveServiced(const uint8_t* data, size_t length);
+    ReceiveResult receive(const uint8_t* data, size_t length, const uint8_t* parity_bits, uint8_t* error_mask);
+    size_t receiveBlock(const uint8_t* data, size_t length, const uint8_t* parity_bits, uint8_t* error_mask,
+                        size_t parity_offset);
+    size_t receiveFiltered(const uint8_t* data, size_t length, const uint8_t* parity_bits, uint8_t* error_mask);
+    size_t rxFlowLevel() const;
+    size_t rxFlowCapacity() const;
+    void throttleRx();
+    void releaseRx();
+    size_t transmit(size_t num_bytes, uint8_t* out);
+    size_t transmitServiced(size_t num_bytes, uint8_t* out);
+    size_t emitTx(size_t num_bytes);
+    size_t rxLevel() const;
+    size_t txLevel() const;
+    size_t rxCapacity() const;
+    void raiseInterrupts(uint32_t raised);
+    size_t drainRxFifo();
+    void refillTxFifo();
     bool txFifoFull() const;
     bool txFifoEmpty() const;
     bool rxFifoFull() const;
     bool rxFifoEmpty() const;
 };
 
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::BasicUARTDriver()
+    : tx_low_watermark(TxDepth / 4)
+    , rx_high_watermark(RxDepth - RxDepth / 4)
+    , interrupt_handler(nullptr)
+    , interrupt_context(nullptr)
+    , dma_handler(nullptr)
+    , dma_context(nullptr)
+    , trace_hook(nullptr)
+    , trace_context(nullptr)
+    , tx_sink(nullptr)
+    , tx_sink_context(nullptr)
+    , flow_mode(0)
+    , rx_stop_level(0)
+    , rx_resume_level(0)
+    , rx_throttled(false)
+    , xoff_received(false)
+    , xoff_sent(false) {
+    // FIFO status bits are derived from the ring indices when read
+    registers.setStatusProvider(&BasicUARTDriver::fifoStatus, this);
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+template <typename BackendArg>
+BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::BasicUARTDriver(BackendArg backend_arg)
+    : registers(backend_arg)
+    , tx_low_watermark(TxDepth / 4)
+    , rx_high_watermark(RxDepth - RxDepth / 4)
+    , interrupt_handler(nullptr)
+    , interrupt_context(nullptr)
+    , dma_handler(nullptr)
+    , dma_context(nullptr)
+    , trace_hook(nullptr)
+    , trace_context(nullptr)
+    , tx_sink(nullptr)
+    , tx_sink_context(nullptr)
+    , flow_mode(0)
+    , rx_stop_level(0)
+    , rx_resume_level(0)
+    , rx_throttled(false)
+    , xoff_received(false)
+    , xoff_sent(false) {
+    registers.setStatusProvider(&BasicUARTDriver::fifoStatus, this);
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+template <typename BackendArg, typename FifoArg>
+BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::BasicUARTDriver(BackendArg backend_arg, FifoArg fifo_arg)
+    : registers(backend_arg)
+    , fifos(fifo_arg)
+    , tx_low_watermark(TxDepth / 4)
+    , rx_high_watermark(RxDepth - RxDepth / 4)
+    , interrupt_handler(nullptr)
+    , interrupt_context(nullptr)
+    , dma_handler(nullptr)
+    , dma_context(nullptr)
+    , trace_hook(nullptr)
+    , trace_context(nullptr)
+    , tx_sink(nullptr)
+    , tx_sink_context(nullptr)
+    , flow_mode(0)
+    , rx_stop_level(0)
+    , rx_resume_level(0)
+    , rx_throttled(false)
+    , xoff_received(false)
+    , xoff_sent(false) {
+    registers.setStatusProvider(&BasicUARTDriver::fifoStatus, this);
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::~BasicUARTDriver() {
+    // Mapped FIFOs belong to a port that outlives this driver object
+    if (Fifos::OWNED) {
+        shutdown();
+    }
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+bool BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::initialize(uint32_t baud_rate, bool enable_parity, bool odd_parity,
+                                                   bool two_stop_bits) {
+    // Reset hardware state
+    registers.reset();
+    
+    // Configure baud rate
+    registers.writeRegister(UART_BAUD_REG, baud_rate);
+    
+    // Configure control register
+    uint32_t ctrl = CTRL_ENABLE | CTRL_TX_ENABLE | CTRL_RX_ENABLE;
+    if (enable_parity) {
+        ctrl |= CTRL_PARITY_EN;
+        if (odd_parity) {
+            ctrl |= CTRL_PARITY_ODD;
+        }
+    }
+    if (two_stop_bits) {
+        ctrl |= CTRL_TWO_STOP;
+    }
+    registers.writeRegister(UART_CONTROL_REG, ctrl);
+    
+    // Clear FIFOs
+    fifos.tx().reset();
+    fifos.rx().reset();
+    tx_buffer.reset();
+    rx_buffer.reset();
+    
+    // Flow control off
+    flow_mode = 0;
+    rx_throttled.store(false, std::memory_order_relaxed);
+    xoff_received.store(false, std::memory_order_relaxed);
+    xoff_sent = false;
+    
+    return registers.isEnabled();
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+void BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::shutdown() {
+    registers.writeRegister(UART_CONTROL_REG, 0);
+    fifos.tx().reset();
+    fifos.rx().reset();
+    tx_buffer.reset();
+    rx_buffer.reset();
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+bool BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::writeByte(uint8_t data) {
+    if (!registers.isTxEnabled()) {
+        return false;
+    }
+    if (trace_hook) {
+        trace_hook(TRACE_TX_WRITE, &data, 1, trace_context);
+    }
+    bool queued = txBuffered() ? tx_buffer.push(data) : fifos.tx().push(data);
+    counters.recordWrite(1, queued ? 1 : 0, txLevel());
+    return queued;
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+size_t BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::writeData(const uint8_t* data, size_t length) {
+    if (!data || !registers.isTxEnabled()) {
+        return 0;
+    }
+    if (trace_hook) {
+        trace_hook(TRACE_TX_WRITE, data, length, trace_context);
+    }
+    
+    size_t queued = txBuffered() ? tx_buffer.write(data, length) : fifos.tx().write(data, length);
+    counters.recordWrite(length, queued, txLevel());
+    return queued;
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+bool BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::readByte(uint8_t& data) {
+    if (!registers.isRxEnabled()) {
+        return false;
+    }
+    bool popped = rxBuffered() ? rx_buffer.pop(data) : fifos.rx().pop(data);
+    if (flow_mode) {
+        releaseRx();
+    }
+    return popped;
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+size_t BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::readData(uint8_t* buffer, size_t max_length) {
+    if (!buffer || !registers.isRxEnabled()) {
+        return 0;
+    }
+    
+    size_t read = rxBuffered() ? rx_buffer.read(buffer, max_length) : fifos.rx().read(buffer, max_length);
+    if (flow_mode) {
+        releaseRx();
+    }
+    return read;
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+ConstByteRegions BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::peekRx() {
+    if (!registers.isRxEnabled()) {
+        ConstByteRegions none = {{nullptr, 0}, {nullptr, 0}};
+        return none;
+    }
+    return rxBuffered() ? rx_buffer.peek() : fifos.rx().peek();
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+size_t BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::consumeRx(size_t num_bytes) {
+    if (!registers.isRxEnabled()) {
+        return 0;
+    }
+    size_t consumed = rxBuffered() ? rx_buffer.discard(num_bytes) : fifos.rx().discard(num_bytes);
+    if (flow_mode) {
+        releaseRx();
+    }
+    return consumed;
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+bool BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::readUntil(uint8_t delimiter, uint8_t* buffer,
+                                                             size_t max_length, size_t& length) {
+    length = 0;
+    if (!buffer || max_length == 0) {
+        return false;
+    }
+    
+    ConstByteRegions regions = peekRx();
+    size_t limit = max_length;
+    size_t first = regions.first.size < limit ? regions.first.size : limit;
+    const void* hit = first ? std::memchr(regions.first.data, delimiter, first) : nullptr;
+    if (hit) {
+        limit = static_cast<const uint8_t*>(hit) - regions.first.data + 1;
+        first = limit;
+    } else if (first < limit) {
+        size_t second = regions.second.size < limit - first ? regions.second.size : limit - first;
+        hit = second ? std::memchr(regions.second.data, delimiter, second) : nullptr;
+        if (hit) {
+            limit = first + (static_cast<const uint8_t*>(hit) - regions.second.data) + 1;
+        } else if (first + second < limit) {
+            return false;  // Partial record: leave it queued
+        }
+    }
+    
+    std::memcpy(buffer, regions.first.data, first);
+    if (limit > first) {
+        std::memcpy(buffer + first, regions.second.data, limit - first);
+    }
+    consumeRx(limit);
+    length = limit;
+    return hit != nullptr;
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+bool BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::readLine(char* line, size_t max_length, size_t& length) {
+    length = 0;
+    if (!line || max_length == 0) {
+        return false;
+    }
+    
+    bool found = readUntil('\n', reinterpret_cast<uint8_t*>(line), max_length - 1, length);
+    if (found) {
+        length--;
+        if (length > 0 && line[length - 1] == '\r') {
+            length--;
+        }
+    }
+    line[length] = '\0';
+    return found;
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+ByteRegions BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::reserveTx(size_t max_length) {
+    if (!registers.isTxEnabled()) {
+        ByteRegions none = {{nullptr, 0}, {nullptr, 0}};
+        return none;
+    }
+    return txBuffered() ? tx_buffer.reserve(max_length) : fifos.tx().reserve(max_length);
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+size_t BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::commitTx(size_t num_bytes) {
+    if (num_bytes == 0 || !registers.isTxEnabled()) {
+        return 0;
+    }
+    if (trace_hook) {
+        // The bytes stay private to this side until commit() publishes them
+        ByteRegions written = txBuffered() ? tx_buffer.reserve(num_bytes) : fifos.tx().reserve(num_bytes);
+        trace_hook(TRACE_TX_WRITE, written.first.data, written.first.size, trace_context);
+        if (written.second.size > 0) {
+            trace_hook(TRACE_TX_WRITE, written.second.data, written.second.size, trace_context);
+        }
+    }
+    size_t queued = txBuffered() ? tx_buffer.commit(num_bytes) : fifos.tx().commit(num_bytes);
+    counters.recordWrite(num_bytes, queued, txLevel());
+    return queued;
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+bool BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::canTransmit() const {
+    if (txBuffered()) {
+        return registers.isTxEnabled() && !tx_buffer.full();
+    }
+    return registers.isTxEnabled() && !txFifoFull();
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+bool BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::hasData() const {
+    if (rxBuffered()) {
+        return registers.isRxEnabled() && !rx_buffer.empty();
+    }
+    return registers.isRxEnabled() && !rxFifoEmpty();
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+size_t BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::getTxFifoCount() const {
+    return fifos.tx().count();
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+size_t BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::getRxFifoCount() const {
+    return fifos.rx().count();
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+bool BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::hasError() const {
+    return registers.isStatusBitSet(STATUS_FRAME_ERR | STATUS_OVERRUN);
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+void BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::clearErrors() {
+    // Write 1 to clear error bits
+    registers.writeRegister(UART_STATUS_REG, STATUS_FRAME_ERR | STATUS_OVERRUN);
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+uint32_t BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::readStatus() const {
+    return registers.readRegister(UART_STATUS_REG);
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+uint32_t BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::readControl() const {
+    return registers.readRegister(UART_CONTROL_REG);
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+ReceiveResult BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::simulateReceive(const uint8_t* data, size_t length) {
+    return receive(data, length, nullptr, nullptr);
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+ReceiveResult BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::receive(const uint8_t* data, size_t length,
+                                                                    const uint8_t* parity_bits, uint8_t* error_mask) {
+    ReceiveResult result = {0, data ? length : 0};
+    if (!data || !registers.isRxEnabled()) {
+        return result;
+    }
+    if (trace_hook) {
+        trace_hook(TRACE_RX, data, length, trace_context);
+    }
+    
+    if (flow_mode & CTRL_XONXOFF) {
+        result.accepted = receiveFiltered(data, length, parity_bits, error_mask);
+    } else {
+        result.accepted = receiveBlock(data, length, parity_bits, error_mask, 0);
+    }
+    if (flow_mode) {
+        throttleRx();
+    }
+    result.dropped = length - result.accepted;
+    return result;
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+size_t BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::receiveBlock(const uint8_t* data, size_t length,
+                                                                  const uint8_t* parity_bits, uint8_t* error_mask,
+                                                                  size_t parity_offset) {
+    size_t received = rxServiced() ? receiveServiced(data, length) : fifos.rx().write(data, length);
+    counters.recordReceive(received, length - received, rxLevel(), rxCapacity());
+    
+    uint32_t raised = 0;
+    if (received < length) {
+        // Set overrun error if FIFO is full
+        registers.setStatusBit(STATUS_OVERRUN);
+        raised |= INT_LINE_ERROR;
+    }
+    if (parity_bits) {
+        // Only characters that made it into the FIFO report parity errors.
+        // With a mask the check has already run; read it and clear the
+        // bits of dropped characters instead of checking again.
+        size_t errors = 0;
+        if (error_mask) {
+            errors = countMaskBits(error_mask, parity_offset, received);
+            clearMaskBits(error_mask, parity_offset + received, length - received);
+        } else if (received > 0) {
+            errors = countParityErrors(data, received, registers.isParityOdd(), parity_bits, parity_offset);
+        }
+        if (errors > 0) {
+            counters.recordFrameErrors(errors);
+            registers.setStatusBit(STATUS_FRAME_ERR);
+            raised |= INT_LINE_ERROR;
+        }
+    }
+    if (rxLevel() >= getRxTriggerLevel()) {
+        raised |= INT_RX_TRIGGER;
+    }
+    raiseInterrupts(raised);
+    return received;
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+ReceiveResult BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::simulateReceive(const uint8_t* data, size_t length,
+                                                                 const uint8_t* parity_bits, uint8_t* error_mask) {
+    if (!data || !registers.isRxEnabled()) {
+        ReceiveResult none = {0, data ? length : 0};
+        return none;
+    }
+    if (!parity_bits || !registers.isParityEnabled()) {
+        if (error_mask) {
+            memset(error_mask, 0, parityMaskBytes(length));
+        }
+        return receive(data, length, nullptr, nullptr);
+    }
+    
+    if (error_mask) {
+        // One pass over every character; receive() keeps the accepted bits
+        checkParityBits(data, length, registers.isParityOdd(), parity_bits, error_mask);
+    }
+    return receive(data, length, parity_bits, error_mask);
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+size_t BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::simulateTransmit(size_t num_bytes) {
+    return transmit(num_bytes, nullptr);
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+size_t BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::drainTx(uint8_t* out, size_t max_length, uint8_t* parity_bits) {
+    if (!out) {
+        return 0;
+    }
+    size_t sent = transmit(max_length, out);
+    if (parity_bits && registers.isParityEnabled()) {
+        computeParityBits(out, sent, registers.isParityOdd(), parity_bits);
+    }
+    return sent;
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+uint32_t BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::getBitsPerCharacter() const {
+    uint32_t bits = 1 + 8 + 1;
+    if (registers.isParityEnabled()) {
+        bits++;
+    }
+    if (registers.isTwoStopBits()) {
+        bits++;
+    }
+    return bits;
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+uint64_t BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::getCharacterTimeNs() const {
+    uint64_t baud = registers.getBaudRate();
+    if (baud == 0) {
+        return 0;
+    }
+    return (getBitsPerCharacter() * 1000000000ULL + baud / 2) / baud;
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+void BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::setInterruptHandler(InterruptHandler handler, void* context) {
+    interrupt_handler = handler;
+    interrupt_context = context;
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+void BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::setDmaRequestHandler(DmaRequestHandler handler, void* context) {
+    dma_handler = handler;
+    dma_context = context;
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+PortStats BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::getStats() const {
+    return counters.snapshot();
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+void BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::resetStats() {
+    counters.reset();
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+void BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::setTxSink(TxSink sink, void* context) {
+    tx_sink = sink;
+    tx_sink_context = context;
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+void BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::setTraceHook(TraceHook hook, void* context) {
+    trace_hook = hook;
+    trace_context = context;
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+void BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::configureInterrupts(uint32_t enable_mask, uint32_t fifo_control) {
+    registers.writeRegister(UART_FIFO_CTRL_REG, fifo_control);
+    registers.writeRegister(UART_INT_ENABLE_REG, enable_mask);
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+uint32_t BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::getPendingInterrupts() const {
+    return registers.getInterruptPending();
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+void BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::clearInterrupts(uint32_t mask) {
+    // Write 1 to clear pending interrupts
+    registers.writeRegister(UART_INT_STATUS_REG, mask);
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+size_t BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::getRxTriggerLevel() const {
+    switch (registers.getFifoControl() & FCR_RX_TRIG_MASK) {
+        case FCR_RX_TRIG_QUARTER:
+            return (RxDepth >= 4) ? RxDepth / 4 : 1;
+        case FCR_RX_TRIG_HALF:
+            return (RxDepth >= 2) ? RxDepth / 2 : 1;
+        case FCR_RX_TRIG_NEAR_FULL:
+            return (RxDepth > 2) ? RxDepth - RxDepth / 8 : RxDepth;
+        default:
+            return 1;
+    }
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+size_t BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::getTxLowWaterLevel() const {
+    switch (registers.getFifoControl() & FCR_TX_LOW_MASK) {
+        case FCR_TX_LOW_QUARTER:
+            return TxDepth / 4;
+        case FCR_TX_LOW_HALF:
+            return TxDepth / 2;
+        case FCR_TX_LOW_3QUARTER:
+            return TxDepth - TxDepth / 4;
+        default:
+            return 0;
+    }
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+bool BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::attachSoftwareBuffers(const SoftwareBufferConfig& config) {
+    detachSoftwareBuffers();
+    
+    DynamicRingStorage& tx_storage = tx_buffer.getStorage();
+    DynamicRingStorage& rx_storage = rx_buffer.getStorage();
+    if (config.tx_capacity > 0) {
+        if (config.tx_memory) {
+            if (!tx_storage.attach(config.tx_memory, config.tx_capacity)) {
+                return false;
+            }
+        } else {
+            tx_storage.allocate(config.tx_capacity);
+        }
+    }
+    if (config.rx_capacity > 0) {
+        if (config.rx_memory) {
+            if (!rx_storage.attach(config.rx_memory, config.rx_capacity)) {
+                tx_storage.release();
+                return false;
+            }
+        } else {
+            rx_storage.allocate(config.rx_capacity);
+        }
+    }
+    
+    if (config.tx_low_watermark > 0) {
+        tx_low_watermark = (config.tx_low_watermark < TxDepth) ? config.tx_low_watermark : TxDepth - 1;
+    }
+    if (config.rx_high_watermark > 0) {
+        rx_high_watermark = (config.rx_high_watermark < RxDepth) ? config.rx_high_watermark : RxDepth;
+    }
+    
+    fifos.tx().reset();
+    fifos.rx().reset();
+    return true;
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+void BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::detachSoftwareBuffers() {
+    tx_buffer.reset();
+    rx_buffer.reset();
+    tx_buffer.getStorage().release();
+    rx_buffer.getStorage().release();
+    tx_low_watermark = TxDepth / 4;
+    rx_high_watermark = RxDepth - RxDepth / 4;
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+void BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::serviceSoftwareBuffers() {
+    if (rxServiced() && registers.isRxEnabled()) {
+        drainRxFifo();
+    }
+    if (txServiced() && registers.isTxEnabled()) {
+        refillTxFifo();
+    }
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+size_t BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::getTxBufferCount() const {
+    return tx_buffer.count();
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+size_t BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::getRxBufferCount() const {
+    return rx_buffer.count();
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+size_t BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::getRxSpace() const {
+    if (!registers.isRxEnabled()) {
+        return 0;
+    }
+    size_t fifo_count = fifos.rx().count();
+    size_t space = (fifo_count < RxDepth) ? RxDepth - fifo_count : 0;
+    if (rxBuffered()) {
+        space += rx_buffer.capacity() - rx_buffer.count();
+    }
+    return space;
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+uint32_t BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::fifoStatus(const void* context) {
+    const BasicUARTDriver* self = static_cast<const BasicUARTDriver*>(context);
+    size_t tx_count = self->fifos.tx().count();
+    size_t rx_count = self->fifos.rx().count();
+    
+    uint32_t status = 0;
+    if (tx_count == 0) {
+        status |= STATUS_TX_EMPTY;
+    } else if (tx_count >= TxDepth) {
+        status |= STATUS_TX_FULL;
+    }
+    if (rx_count == 0) {
+        status |= STATUS_RX_EMPTY;
+    } else if (rx_count >= RxDepth) {
+        status |= STATUS_RX_FULL;
+    }
+    return status;
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+bool BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::txBuffered() const {
+    return tx_buffer.capacity() != 0;
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+bool BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::rxBuffered() const {
+    return rx_buffer.capacity() != 0;
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+bool BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::txServiced() const {
+    return txBuffered() || dma_handler != nullptr;
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+bool BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::rxServiced() const {
+    return rxBuffered() || dma_handler != nullptr;
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+size_t BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::receiveServiced(const uint8_t* data, size_t length) {
+    size_t received = 0;
+    while (received < length) {
+        size_t level = fifos.rx().count();
+        if (level >= rx_high_watermark) {
+            // RX watermark reached: service the FIFO (software buffer or DMA)
+            if (drainRxFifo() == 0) {
+                // Nobody took data: whatever still fits stays in the FIFO
+                received += fifos.rx().write(data + received, length - received);
+                break;
+            }
+            continue;
+        }
+        
+        size_t chunk = rx_high_watermark - level;
+        if (chunk > length - received) {
+            chunk = length - received;
+        }
+        received += fifos.rx().write(data + received, chunk);
+    }
+    
+    // End of burst (RX timeout): hand the remainder to the application
+    drainRxFifo();
+    return received;
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+size_t BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::transmit(size_t num_bytes, uint8_t* out) {
+    if (!registers.isTxEnabled()) {
+        return 0;
+    }
+    
+    size_t before = txLevel();
+    size_t control = 0;
+    if ((flow_mode & CTRL_XONXOFF) && num_bytes > 0) {
+        // A change of throttle state is announced ahead of data, even while paused
+        bool throttled = rx_throttled.load(std::memory_order_acquire);
+        if (throttled != xoff_sent) {
+            uint8_t announce = throttled ? XOFF_CHAR : XON_CHAR;
+            if (out) {
+                *out++ = announce;
+            } else if (tx_sink) {
+                ConstByteRegions control_char = {{&announce, 1}, {nullptr, 0}};
+                tx_sink(control_char, tx_sink_context);
+            }
+            xoff_sent = throttled;
+            control = 1;
+            num_bytes--;
+        }
+    }
+    
+    size_t sent = 0;
+    if (!isTxPaused()) {
+        if (!txServiced()) {
+            // Simulate transmitting the bytes (remove them from the FIFO)
+            sent = out ? fifos.tx().read(out, num_bytes) : emitTx(num_bytes);
+        } else {
+            sent = transmitServiced(num_bytes, out);
+        }
+    }
+    sent += control;
+    counters.recordTransmit(sent);
+    if (trace_hook && sent > 0) {
+        // Idle polls (drainTx with nothing queued) leave no record
+        trace_hook(TRACE_TX_DONE, nullptr, sent, trace_context);
+    }
+    
+    // TX low-water interrupt fires when the level crosses down to the threshold
+    size_t low_water = getTxLowWaterLevel();
+    if (before > low_water && txLevel() <= low_water) {
+        raiseInterrupts(INT_TX_LOW);
+    }
+    return sent;
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+size_t BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::transmitServiced(size_t num_bytes, uint8_t* out) {
+    size_t remaining = num_bytes;
+    while (remaining > 0) {
+        refillTxFifo();
+        size_t level = fifos.tx().count();
+        if (level == 0) {
+            break;
+        }
+        
+        // Transmit down to the low watermark, where the FIFO is refilled
+        size_t chunk = (level > tx_low_watermark) ? level - tx_low_watermark : level;
+        if (chunk > remaining) {
+            chunk = remaining;
+        }
+        size_t sent = out ? fifos.tx().read(out + (num_bytes - remaining), chunk) : emitTx(chunk);
+        remaining -= sent;
+    }
+    refillTxFifo();
+    return num_bytes - remaining;
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+size_t BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::emitTx(size_t num_bytes) {
+    if (!tx_sink) {
+        return fifos.tx().discard(num_bytes);
+    }
+    
+    // Hand the sink both ring segments in place, trimmed to num_bytes
+    ConstByteRegions data = fifos.tx().peek();
+    if (data.first.size >= num_bytes) {
+        data.first.size = num_bytes;
+        data.second.size = 0;
+    } else if (data.second.size > num_bytes - data.first.size) {
+        data.second.size = num_bytes - data.first.size;
+    }
+    size_t sent = data.size();
+    if (sent > 0) {
+        tx_sink(data, tx_sink_context);
+    }
+    return fifos.tx().discard(sent);
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+bool BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::configureFlowControl(uint32_t mode, size_t stop_level, size_t resume_level) {
+    size_t capacity = rxFlowCapacity();
+    size_t stop = stop_level ? stop_level : capacity - capacity / 4;
+    size_t resume = resume_level ? resume_level : capacity / 4;
+    if ((mode & ~CTRL_FLOW_MASK) != 0 || resume >= stop || stop > capacity) {
+        return false;
+    }
+    
+    registers.writeRegister(UART_CONTROL_REG, (readControl() & ~CTRL_FLOW_MASK) | mode);
+    flow_mode = mode;
+    rx_stop_level = stop;
+    rx_resume_level = resume;
+    rx_throttled.store(false, std::memory_order_relaxed);
+    xoff_received.store(false, std::memory_order_relaxed);
+    xoff_sent = false;
+    if (mode & CTRL_RTSCTS) {
+        // An idle peer reads as clear-to-send until setCts() says otherwise
+        registers.setStatusBit(STATUS_CTS);
+    }
+    return true;
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+void BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::setCts(bool asserted) {
+    if (asserted) {
+        registers.setStatusBit(STATUS_CTS);
+    } else {
+        registers.clearStatusBit(STATUS_CTS);
+    }
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+bool BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::isRtsAsserted() const {
+    return !rx_throttled.load(std::memory_order_acquire);
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+bool BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::isTxPaused() const {
+    if ((flow_mode & CTRL_RTSCTS) && !registers.isStatusBitSet(STATUS_CTS)) {
+        return true;
+    }
+    return (flow_mode & CTRL_XONXOFF) && xoff_received.load(std::memory_order_relaxed);
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+bool BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::isFlowCharPending() const {
+    return (flow_mode & CTRL_XONXOFF) && rx_throttled.load(std::memory_order_acquire) != xoff_sent;
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+size_t BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::receiveFiltered(const uint8_t* data, size_t length,
+                                                                     const uint8_t* parity_bits, uint8_t* error_mask) {
+    size_t accepted = 0;
+    size_t start = 0;
+    for (size_t i = 0; i < length; i++) {
+        // XON (0x11) and XOFF (0x13) differ only in bit 1
+        if ((data[i] & ~0x02) != XON_CHAR) {
+            continue;
+        }
+        if (i > start) {
+            accepted += receiveBlock(data + start, i - start, parity_bits, error_mask, start);
+        }
+        if (error_mask) {
+            clearMaskBits(error_mask, i, 1);
+        }
+        xoff_received.store(data[i] == XOFF_CHAR, std::memory_order_relaxed);
+        accepted++;
+        start = i + 1;
+    }
+    if (length > start) {
+        accepted += receiveBlock(data + start, length - start, parity_bits, error_mask, start);
+    }
+    return accepted;
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+size_t BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::rxFlowLevel() const {
+    return fifos.rx().count() + (rxBuffered() ? rx_buffer.count() : 0);
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+size_t BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::rxFlowCapacity() const {
+    return RxDepth + (rxBuffered() ? rx_buffer.capacity() : 0);
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+void BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::throttleRx() {
+    if (rx_throttled.load(std::memory_order_relaxed) || rxFlowLevel() < rx_stop_level) {
+        return;
+    }
+    rx_throttled.store(true, std::memory_order_release);
+    // Pairs with releaseRx(): if the application drained the FIFO while we
+    // were deciding, it may have missed the throttle, so undo it here
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (rxFlowLevel() <= rx_resume_level) {
+        bool expected = true;
+        rx_throttled.compare_exchange_strong(expected, false, std::memory_order_acq_rel);
+    }
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+void BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::releaseRx() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!rx_throttled.load(std::memory_order_relaxed) || rxFlowLevel() > rx_resume_level) {
+        return;
+    }
+    bool expected = true;
+    rx_throttled.compare_exchange_strong(expected, false, std::memory_order_acq_rel);
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+size_t BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::rxLevel() const {
+    return rxBuffered() ? rx_buffer.count() : fifos.rx().count();
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+size_t BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::txLevel() const {
+    return txBuffered() ? tx_buffer.count() + fifos.tx().count() : fifos.tx().count();
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+size_t BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::rxCapacity() const {
+    return rxBuffered() ? rx_buffer.capacity() : RxDepth;
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+void BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::raiseInterrupts(uint32_t raised) {
+    if (raised == 0) {
+        return;
+    }
+    registers.setInterruptPending(raised);
+    
+    uint32_t active = raised & registers.getInterruptEnable();
+    if (active && interrupt_handler) {
+        interrupt_handler(active, interrupt_context);
+    }
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+size_t BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::drainRxFifo() {
+    size_t before = fifos.rx().count();
+    if (rxBuffered()) {
+        fifos.rx().transferTo(rx_buffer, RxDepth);
+    }
+    if (dma_handler && rxLevel() > 0) {
+        // DMA reads through readData(), from the software buffer if attached
+        dma_handler(DMA_REQ_RX, dma_context);
+    }
+    return before - fifos.rx().count();
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+void BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::refillTxFifo() {
+    if (fifos.tx().count() > tx_low_watermark) {
+        return;
+    }
+    if (dma_handler) {
+        // DMA writes through writeData(), into the software buffer if attached
+        dma_handler(DMA_REQ_TX, dma_context);
+    }
+    if (txBuffered()) {
+        tx_buffer.transferTo(fifos.tx(), TxDepth);
+    }
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+bool BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::txFifoFull() const {
+    return fifos.tx().full();
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+bool BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::txFifoEmpty() const {
+    return fifos.tx().empty();
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+bool BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::rxFifoFull() const {
+    return fifos.rx().full();
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+bool BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::rxFifoEmpty() const {
+    return fifos.rx().empty();
+}
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+constexpr size_t BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::TX_FIFO_DEPTH;
+
+template <size_t TxDepth, size_t RxDepth, typename Registers, typename Fifos>
+constexpr size_t BasicUARTDriver<TxDepth, RxDepth, Registers, Fifos>::RX_FIFO_DEPTH;
+
+// Default part: 16-entry TX and RX FIFOs, instantiated once in uart_driver.cpp
+typedef BasicUARTDriver<FIFO_DEPTH, FIFO_DEPTH> UARTDriver;
+extern template class BasicUARTDriver<FIFO_DEPTH, FIFO_DEPTH>;
+
+// Default part over a mapped register block (construct with the block pointer)
+typedef BasicUARTDriver<FIFO_DEPTH, FIFO_DEPTH, MappedUARTRegisters> MappedUARTDriver;
+
 } // namespace uart
 
 #endif // UART_DRIVER_H
@@ -0,0 +1,470 @@
+#ifndef UART_FRAMING_H
+#define UART_FRAMING_H
+
+#include "uart_driver.h"
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+
+namespace uart {
+
+// COBS frame delimiter
+constexpr uint8_t COBS_DELIMITER = 0x00;
+
+// SLIP special bytes (RFC 1055)
+constexpr uint8_t SLIP_END     = 0xC0;  // Frame delimiter
+constexpr uint8_t SLIP_ESC     = 0xDB;  // Escape prefix
+constexpr uint8_t SLIP_ESC_END = 0xDC;  // Escaped END
+constexpr uint8_t SLIP_ESC_ESC = 0xDD;  // Escaped ESC
+
+/**
+ * @brief Called once per decoded frame
+ * @param frame Decoded payload; valid only for the duration of the call
+ */
+typedef void (*FrameHandler)(const uint8_t* frame, size_t length, void* context);
+
+/**
+ * @brief Per-decoder counters
+ */
+struct FramingStats {
+    uint64_t frames;      // Frames delivered
+    uint64_t errors;      // Malformed frames dropped
+    uint64_t overflows;   // Frames dropped for exceeding the frame limit
+};
+
+/**
+ * @brief Consistent Overhead Byte Stuffing with a 0x00 frame delimiter
+ *
+ * The encoder finds each zero with memchr and emits the run before it with
+ * one memcpy; the decoder finds delimiters with memchr and expands runs with
+ * memmove, so both sides move data in bulk rather than per byte.
+ */
+class CobsCodec {
+public:
+    /**
+     * @brief Largest encoding of length bytes, including the delimiter
+     */
+    static size_t maxEncodedSize(size_t length) {
+        return length + length / 254 + 2;
+    }
+
+    /**
+     * @brief Encode one frame and append the delimiter
+     * @param out At least maxEncodedSize(length) bytes
+     * @return Bytes written
+     */
+    static size_t encode(const uint8_t* data, size_t length, uint8_t* out) {
+        uint8_t* start = out;
+        for (;;) {
+            size_t n = (length < 254) ? length : 254;
+            const uint8_t* zero = n ? static_cast<const uint8_t*>(memchr(data, 0, n)) : nullptr;
+            if (zero) {
+                size_t run = static_cast<size_t>(zero - data);
+                *out++ = static_cast<uint8_t>(run + 1);
+                memcpy(out, data, run);
+                out += run;
+                data += run + 1;
+                length -= run + 1;
+                continue;
+            }
+            // No zero in the next n bytes: a full block (0xFF) implies none
+            *out++ = static_cast<uint8_t>(n + 1);
+            if (n) {
+                memcpy(out, data, n);
+            }
+            out += n;
+            data += n;
+            length -= n;
+            if (n < 254 || length == 0) {
+                break;
+            }
+        }
+        *out++ = COBS_DELIMITER;
+        return static_cast<size_t>(out - start);
+    }
+
+    /**
+     * @brief Streaming decoder; frames may span any number of feed() calls
+     */
+    class Decoder {
+    public:
+        /**
+         * @param max_frame Largest decoded frame accepted
+         */
+        explicit Decoder(size_t max_frame)
+            : capacity(maxEncodedSize(max_frame) - 1)
+            , buffer(new uint8_t[capacity])
+            , used(0)
+            , overflow(false) {
+            resetStats();
+        }
+
+        /**
+         * @brief Decode a chunk of the byte stream
+         * @return Number of frames delivered to handler
+         */
+        size_t feed(const uint8_t* data, size_t length, FrameHandler handler, void* context) {
+            size_t delivered = 0;
+            while (length > 0) {
+                const uint8_t* delim = static_cast<const uint8_t*>(memchr(data, COBS_DELIMITER, length));
+                size_t chunk = delim ? static_cast<size_t>(delim - data) : length;
+                append(data, chunk);
+                if (!delim) {
+                    break;
+                }
+                delivered += finishFrame(handler, context);
+                data += chunk + 1;
+                length -= chunk + 1;
+            }
+            return delivered;
+        }
+
+        /**
+         * @brief Drop any partial frame
+         */
+        void reset() {
+            used = 0;
+            overflow = false;
+        }
+
+        const FramingStats& getStats() const { return stats; }
+
+        void resetStats() {
+            stats.frames = 0;
+            stats.errors = 0;
+            stats.overflows = 0;
+        }
+
+    private:
+        size_t capacity;
+        std::unique_ptr<uint8_t[]> buffer;
+        size_t used;
+        bool overflow;
+        FramingStats stats;
+
+        void append(const uint8_t* data, size_t length) {
+            if (overflow || length == 0) {
+                return;
+            }
+            if (length > capacity - used) {
+                overflow = true;
+                return;
+            }
+            memcpy(buffer.get() + used, data, length);
+            used += length;
+        }
+
+        size_t finishFrame(FrameHandler handler, void* context) {
+            size_t delivered = 0;
+            if (overflow) {
+                stats.overflows++;
+            } else if (used > 0) {
+                size_t length = 0;
+                if (decodeInPlace(buffer.get(), used, length)) {
+                    stats.frames++;
+                    delivered = 1;
+                    if (handler) {
+                        handler(buffer.get(), length, context);
+                    }
+                } else {
+                    stats.errors++;
+                }
+            }
+            reset();
+            return delivered;
+        }
+
+        // Output never overtakes input, so runs can be moved down in place
+        static bool decodeInPlace(uint8_t* frame, size_t length, size_t& out_length) {
+            size_t in = 0;
+            size_t out = 0;
+            while (in < length) {
+                uint8_t code = frame[in++];
+                size_t run = static_cast<size_t>(code) - 1;
+                if (code == 0 || run > length - in) {
+                    return false;
+                }
+                memmove(frame + out, frame + in, run);
+                out += run;
+                in += run;
+                if (code != 0xFF && in < length) {
+                    frame[out++] = 0;
+                }
+            }
+            out_length = out;
+            return true;
+        }
+
+        Decoder(const Decoder&) = delete;
+        Decoder& operator=(const Decoder&) = delete;
+    };
+};
+
+/**
+ * @brief SLIP (RFC 1055) framing with END delimiters and ESC escapes
+ *
+ * Special bytes are located with memchr and the runs between them are
+ * copied in bulk. Frames are sent with a leading END as well as a trailing
+ * one, which flushes line noise at the receiver.
+ */
+class SlipCodec {
+public:
+    static size_t maxEncodedSize(size_t length) {
+        return 2 * length + 2;
+    }
+
+    static size_t encode(const uint8_t* data, size_t length, uint8_t* out) {
+        uint8_t* start = out;
+        const uint8_t* end = data + length;
+        *out++ = SLIP_END;
+
+        // Next END and ESC in the input, each refreshed only once passed
+        const uint8_t* next_end = find(data, end, SLIP_END);
+        const uint8_t* next_esc = find(data, end, SLIP_ESC);
+        for (;;) {
+            const uint8_t* special = (next_end < next_esc) ? next_end : next_esc;
+            size_t run = static_cast<size_t>(special - data);
+            if (run) {
+                memcpy(out, data, run);
+            }
+            out += run;
+            if (special == end) {
+                break;
+            }
+            *out++ = SLIP_ESC;
+            *out++ = (*special == SLIP_END) ? SLIP_ESC_END : SLIP_ESC_ESC;
+            data = special + 1;
+            if (special == next_end) {
+                next_end = find(data, end, SLIP_END);
+            } else {
+                next_esc = find(data, end, SLIP_ESC);
+            }
+        }
+
+        *out++ = SLIP_END;
+        return static_cast<size_t>(out - start);
+    }
+
+    /**
+     * @brief Streaming decoder; frames and escapes may span feed() calls
+     */
+    class Decoder {
+    public:
+        explicit Decoder(size_t max_frame)
+            : capacity(max_frame)
+            , buffer(new uint8_t[max_frame ? max_frame : 1])
+            , used(0)
+            , escaped(false)
+            , bad(false)
+            , overflow(false) {
+            resetStats();
+        }
+
+        size_t feed(const uint8_t* data, size_t length, FrameHandler handler, void* context) {
+            size_t delivered = 0;
+            const uint8_t* end = data + length;
+            while (data < end) {
+                const uint8_t* delim = find(data, end, SLIP_END);
+                unescape(data, delim);
+                if (delim == end) {
+                    break;
+                }
+                delivered += finishFrame(handler, context);
+                data = delim + 1;
+            }
+            return delivered;
+        }
+
+        void reset() {
+            used = 0;
+            escaped = false;
+            bad = false;
+            overflow = false;
+        }
+
+        const FramingStats& getStats() const { return stats; }
+
+        void resetStats() {
+            stats.frames = 0;
+            stats.errors = 0;
+            stats.overflows = 0;
+        }
+
+    private:
+        size_t capacity;
+        std::unique_ptr<uint8_t[]> buffer;
+        size_t used;
+        bool escaped;    // Segment ended right after an ESC
+        bool bad;        // Invalid escape seen in this frame
+        bool overflow;
+        FramingStats stats;
+
+        void append(const uint8_t* data, size_t length) {
+            if (overflow || length == 0) {
+                return;
+            }
+            if (length > capacity - used) {
+                overflow = true;
+                return;
+            }
+            memcpy(buffer.get() + used, data, length);
+            used += length;
+        }
+
+        // Copy [data, limit), which holds no END, translating escapes
+        void unescape(const uint8_t* data, const uint8_t* limit) {
+            if (escaped && data < limit) {
+                escaped = false;
+                translate(*data++);
+            }
+            while (data < limit) {
+                const uint8_t* esc = find(data, limit, SLIP_ESC);
+                append(data, static_cast<size_t>(esc - data));
+                if (esc == limit) {
+                    return;
+                }
+                if (esc + 1 == limit) {
+                    escaped = true;
+                    return;
+                }
+                translate(esc[1]);
+                data = esc + 2;
+            }
+        }
+
+        void translate(uint8_t code) {
+            uint8_t value;
+            if (code == SLIP_ESC_END) {
+                value = SLIP_END;
+            } else if (code == SLIP_ESC_ESC) {
+                value = SLIP_ESC;
+            } else {
+                bad = true;
+                return;
+            }
+            append(&value, 1);
+        }
+
+        size_t finishFrame(FrameHandler handler, void* context) {
+            size_t delivered = 0;
+            if (escaped) {
+                bad = true;
+            }
+            if (overflow) {
+                stats.overflows++;
+            } else if (bad) {
+                stats.errors++;
+            } else if (used > 0) {
+                stats.frames++;
+                delivered = 1;
+                if (handler) {
+                    handler(buffer.get(), used, context);
+                }
+            }
+            reset();
+            return delivered;
+        }
+
+        Decoder(const Decoder&) = delete;
+        Decoder& operator=(const Decoder&) = delete;
+    };
+
+private:
+    // Position of value in [data, end), or end
+    static const uint8_t* find(const uint8_t* data, const uint8_t* end, uint8_t value) {
+        if (data == end) {
+            return end;
+        }
+        const void* hit = memchr(data, value, static_cast<size_t>(end - data));
+        return hit ? static_cast<const uint8_t*>(hit) : end;
+    }
+};
+
+/**
+ * @brief Packet framing over a driver's application side
+ *
+ * sendFrame() encodes a frame into a staging buffer and queues as much as
+ * the TX path accepts; flush() pushes the rest. receive() decodes straight
+ * out of the RX ring through peekRx()/consumeRx(), so received bytes are
+ * copied once, into the frame being assembled.
+ */
+template <typename Driver, typename Codec>
+class BasicFrameChannel {
+public:
+    /**
+     * @param frame_limit Largest frame sent or accepted, in decoded bytes
+     */
+    BasicFrameChannel(Driver& driver, size_t frame_limit)
+        : uart(driver)
+        , max_frame(frame_limit)
+        , staging(new uint8_t[Codec::maxEncodedSize(frame_limit)])
+        , staged_start(0)
+        , staged_end(0)
+        , decoder(frame_limit) {
+    }
+
+    /**
+     * @brief Encode and queue one frame
+     * @return false if the frame is too large or the previous frame has
+     *         not been fully queued yet (call flush() and retry)
+     */
+    bool sendFrame(const uint8_t* data, size_t length) {
+        if (length > max_frame || flush() > 0) {
+            return false;
+        }
+        staged_start = 0;
+        staged_end = Codec::encode(data, length, staging.get());
+        flush();
+        return true;
+    }
+
+    /**
+     * @brief Queue staged bytes into the TX path
+     * @return Bytes still staged
+     */
+    size_t flush() {
+        if (staged_start < staged_end) {
+            staged_start += uart.writeData(staging.get() + staged_start, staged_end - staged_start);
+        }
+        return staged_end - staged_start;
+    }
+
+    size_t pendingTx() const { return staged_end - staged_start; }
+
+    /**
+     * @brief Decode everything currently received
+     * @return Number of frames delivered to handler
+     */
+    size_t receive(FrameHandler handler, void* context) {
+        size_t delivered = 0;
+        for (;;) {
+            ConstByteRegions rx = uart.peekRx();
+            if (rx.size() == 0) {
+                return delivered;
+            }
+            delivered += decoder.feed(rx.first.data, rx.first.size, handler, context);
+            if (rx.second.size) {
+                delivered += decoder.feed(rx.second.data, rx.second.size, handler, context);
+            }
+            uart.consumeRx(rx.size());
+        }
+    }
+
+    typename Codec::Decoder& getDecoder() { return decoder; }
+
+private:
+    Driver& uart;
+    size_t max_frame;
+    std::unique_ptr<uint8_t[]> staging;
+    size_t staged_start;
+    size_t staged_end;
+    typename Codec::Decoder decoder;
+};
+
+typedef BasicFrameChannel<UARTDriver, CobsCodec> CobsChannel;
+typedef BasicFrameChannel<UARTDriver, SlipCodec> SlipChannel;
+
+} // namespace uart
+
+#endif // UART_FRAMING_H
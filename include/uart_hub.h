@@ -0,0 +1,221 @@
+#ifndef UART_HUB_H
+#define UART_HUB_H
+
+#include "uart_driver.h"
+#include "uart_port_event.h"
+#include "uart_worker_pool.h"
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace uart {
+
+/**
+ * @brief Owns many UART ports and reports which ones need service
+ *
+ * Readiness works like a level-triggered epoll set. Each port's interrupt
+ * handler marks it in a candidate bitmap (RX data, TX low water, line error),
+ * and poll() visits only marked ports, so an idle port costs one bit per
+ * scan. A port stays marked while it is still ready for an event of interest.
+ *
+ * Writability is the exception: once a port's TX FIFO fills it drops out, and
+ * only the TX low-water interrupt (three quarters of FIFO_DEPTH) marks it
+ * again. Space freed above that level is not reported, so HUB_WRITABLE is
+ * edge-triggered at the low-water mark; a handler that stops writing early
+ * keeps the port marked and sees it writable on every poll.
+ *
+ * service() polls and then dispatches the ready ports to a fixed worker pool.
+ * Ports are sharded contiguously across workers and hot ports are balanced
+ * by work stealing. While a handler runs it is the application side of its
+ * port; device-side calls may continue concurrently from other threads.
+ *
+ * Ports must be initialized through the hub so the readiness interrupts are
+ * configured; the hub owns each port's interrupt handler.
+ */
+template <typename Driver>
+class BasicUARTHub {
+public:
+    typedef std::function<void(size_t port, uint32_t events, Driver& uart)> PortHandler;
+
+    /**
+     * @param num_ports Number of ports to create
+     * @param num_threads Worker threads for service(); 0 = hardware concurrency
+     */
+    explicit BasicUARTHub(size_t num_ports, size_t num_threads = 0)
+        : num_ports(num_ports)
+        , num_words((num_ports + 63) / 64)
+        , ports(new Driver[num_ports])
+        , interest(new uint32_t[num_ports])
+        , contexts(new PortContext[num_ports])
+        , candidates(new std::atomic<uint64_t>[num_words])
+        , pool(num_threads) {
+        for (size_t i = 0; i < num_words; i++) {
+            candidates[i].store(0, std::memory_order_relaxed);
+        }
+        for (size_t i = 0; i < num_ports; i++) {
+            interest[i] = HUB_READABLE;
+            contexts[i].hub = this;
+            contexts[i].index = i;
+            ports[i].setInterruptHandler(&BasicUARTHub::onInterrupt, &contexts[i]);
+        }
+    }
+
+    size_t size() const { return num_ports; }
+
+    Driver& port(size_t index) { return ports[index]; }
+
+    size_t getWorkerCount() const { return pool.size(); }
+
+    /**
+     * @brief Initialize one port and arm its readiness interrupts
+     */
+    bool initializePort(size_t index, uint32_t baud_rate, bool enable_parity = false, bool odd_parity = false) {
+        bool ok = ports[index].initialize(baud_rate, enable_parity, odd_parity);
+        ports[index].configureInterrupts(INT_RX_TRIGGER | INT_TX_LOW | INT_LINE_ERROR,
+                                         FCR_RX_TRIG_1 | FCR_TX_LOW_3QUARTER);
+        // A freshly initialized port has TX space
+        markCandidate(index);
+        return ok;
+    }
+
+    /**
+     * @brief Initialize every port with the same configuration
+     */
+    bool initialize(uint32_t baud_rate, bool enable_parity = false, bool odd_parity = false) {
+        bool ok = true;
+        for (size_t i = 0; i < num_ports; i++) {
+            ok = initializePort(i, baud_rate, enable_parity, odd_parity) && ok;
+        }
+        return ok;
+    }
+
+    /**
+     * @brief Select the HUB_* events poll() reports for a port
+     * A full port asking for HUB_WRITABLE is reported once TX drains to the
+     * low-water mark, not at the first free byte.
+     */
+    void setInterest(size_t index, uint32_t events) {
+        interest[index] = events;
+        markCandidate(index);
+    }
+
+    /**
+     * @brief Collect ready ports
+     * @return Number of entries written to events
+     */
+    size_t poll(PortEvent* events, size_t max_events) {
+        size_t found = 0;
+        for (size_t w = 0; w < num_words && found < max_events; w++) {
+            if (candidates[w].load(std::memory_order_relaxed) == 0) {
+                continue;
+            }
+            // Claim the word first so a concurrent interrupt re-marks its port
+            uint64_t bits = candidates[w].exchange(0, std::memory_order_acq_rel);
+            uint64_t keep = 0;
+            while (bits) {
+                unsigned bit = lowestBit(bits);
+                bits &= bits - 1;
+                size_t index = w * 64 + bit;
+                if (found == max_events) {
+                    keep |= 1ULL << bit;
+                    continue;
+                }
+                uint32_t ready = readiness(index);
+                if (ready) {
+                    events[found].port = index;
+                    events[found].events = ready;
+                    found++;
+                    keep |= 1ULL << bit;  // Level-triggered: stays marked
+                }
+            }
+            if (keep) {
+                candidates[w].fetch_or(keep, std::memory_order_release);
+            }
+        }
+        return found;
+    }
+
+    /**
+     * @brief Poll and run handler for every ready port on the worker pool
+     * @return Number of ports serviced
+     */
+    size_t service(const PortHandler& handler) {
+        ready_events.resize(num_ports);
+        size_t count = poll(ready_events.data(), ready_events.size());
+        ready_ports.resize(count);
+        for (size_t i = 0; i < count; i++) {
+            ready_ports[i] = i;
+        }
+        pool.run(ready_ports.data(), count, [this, &handler](size_t slot) {
+            const PortEvent& event = ready_events[slot];
+            handler(event.port, event.events, ports[event.port]);
+        });
+        return count;
+    }
+
+private:
+    struct PortContext {
+        BasicUARTHub* hub;
+        size_t index;
+    };
+
+    size_t num_ports;
+    size_t num_words;
+    std::unique_ptr<Driver[]> ports;
+    std::unique_ptr<uint32_t[]> interest;
+    std::unique_ptr<PortContext[]> contexts;
+    std::unique_ptr<std::atomic<uint64_t>[]> candidates;
+    std::vector<PortEvent> ready_events;
+    std::vector<size_t> ready_ports;
+    WorkerPool pool;
+
+    static void onInterrupt(uint32_t, void* context) {
+        PortContext* port = static_cast<PortContext*>(context);
+        port->hub->markCandidate(port->index);
+    }
+
+    void markCandidate(size_t index) {
+        uint64_t bit = 1ULL << (index % 64);
+        std::atomic<uint64_t>& word = candidates[index / 64];
+        if ((word.load(std::memory_order_relaxed) & bit) == 0) {
+            word.fetch_or(bit, std::memory_order_release);
+        }
+    }
+
+    uint32_t readiness(size_t index) {
+        Driver& uart = ports[index];
+        uint32_t ready = 0;
+        if (uart.hasData()) {
+            ready |= HUB_READABLE;
+        }
+        if (uart.canTransmit()) {
+            ready |= HUB_WRITABLE;
+        }
+        if (uart.hasError()) {
+            ready |= HUB_ERROR;
+        }
+        return ready & interest[index];
+    }
+
+    static unsigned lowestBit(uint64_t bits) {
+#if defined(__GNUC__)
+        return static_cast<unsigned>(__builtin_ctzll(bits));
+#else
+        unsigned bit = 0;
+        while ((bits & 1) == 0) {
+            bits >>= 1;
+            bit++;
+        }
+        return bit;
+#endif
+    }
+};
+
+typedef BasicUARTHub<UARTDriver> UARTHub;
+
+} // namespace uart
+
+#endif // UART_HUB_H
@@ -0,0 +1,167 @@
+#ifndef UART_LINK_H
+#define UART_LINK_H
+
+#include "uart_driver.h"
+#include <cstdint>
+#include <cstddef>
+
+namespace uart {
+
+/**
+ * @brief Per-direction counters for a BasicUARTLink
+ */
+struct LinkDirectionStats {
+    uint64_t bytes;      // Characters carried across the link
+    uint64_t blocks;     // Block transfers performed
+    uint64_t stalls;     // Transfers held back by flow control or a paused sender
+    uint64_t dropped;    // Characters the receiver lost to overrun
+};
+
+/**
+ * @brief Null-modem cable between two drivers
+ *
+ * Each side's TX line is wired to the other side's RX line. transfer()
+ * drains transmitted characters from one driver with drainTx() and delivers
+ * them to the peer with simulateReceive() in blocks, carrying parity bits
+ * when the sender generates them, so the peer's parity check and
+ * statistics see real line traffic.
+ *
+ * With flow control crossed over, a sender only transmits as many
+ * characters as the peer's receive path can hold (the peer's RX readiness
+ * drives the sender's clear-to-send); characters that do not fit stay queued
+ * on the sender. Without it, the line runs freely and the peer overruns as
+ * real hardware would.
+ *
+ * Drivers' own flow control also works across the link. When the receiver
+ * uses CTRL_RTSCTS, its RTS output drives the sender's CTS input before each
+ * block. CTS is sampled per block, not per character, so a block that starts
+ * with RTS asserted runs to completion: the receiver may take up to one
+ * block (BLOCK_SIZE characters) past the level at which it drops RTS. Each
+ * block is also clamped to the receiver's free room, so that overshoot never
+ * overruns it. XON/XOFF characters travel in-band with the data; the
+ * peer reacts once they arrive, so small transfers keep the skid short.
+ *
+ * The link is the device side of both drivers: only one thread may call
+ * transfer() at a time, while each driver's application side runs freely.
+ */
+template <typename Driver>
+class BasicUARTLink {
+public:
+    // Characters moved per block
+    static constexpr size_t BLOCK_SIZE = 256;
+
+    enum Direction {
+        A_TO_B = 0,
+        B_TO_A = 1
+    };
+
+    BasicUARTLink(Driver& a, Driver& b, bool cross_flow_control = false)
+        : side_a(a)
+        , side_b(b)
+        , flow_control(cross_flow_control) {
+        resetStats();
+    }
+
+    void setFlowControl(bool enable) { flow_control = enable; }
+    bool getFlowControl() const { return flow_control; }
+
+    /**
+     * @brief Carry up to max_bytes in one direction
+     * @return Characters delivered to the receiver (including any it dropped)
+     */
+    size_t transfer(Direction direction, size_t max_bytes) {
+        Driver& from = (direction == A_TO_B) ? side_a : side_b;
+        Driver& to = (direction == A_TO_B) ? side_b : side_a;
+        LinkDirectionStats& dir = stats[direction];
+
+        uint8_t block[BLOCK_SIZE];
+        uint8_t parity[BLOCK_SIZE / 8];
+        size_t moved = 0;
+        while (moved < max_bytes) {
+            size_t want = max_bytes - moved;
+            if (want > BLOCK_SIZE) {
+                want = BLOCK_SIZE;
+            }
+            bool hardware = (to.readControl() & CTRL_RTSCTS) != 0;
+            if (hardware) {
+                from.setCts(to.isRtsAsserted());
+            }
+            if (flow_control || hardware) {
+                size_t space = to.getRxSpace();
+                if (space == 0) {
+                    dir.stalls++;
+                    break;
+                }
+                if (want > space) {
+                    want = space;
+                }
+            }
+
+            bool with_parity = (from.readControl() & CTRL_PARITY_EN) != 0;
+            size_t sent = from.drainTx(block, want, with_parity ? parity : nullptr);
+            if (sent == 0) {
+                if (from.isTxPaused() && from.getTxFifoCount() > 0) {
+                    dir.stalls++;
+                }
+                break;
+            }
+            ReceiveResult received = to.simulateReceive(block, sent, with_parity ? parity : nullptr);
+            dir.dropped += received.dropped;
+            moved += sent;
+            dir.bytes += sent;
+            dir.blocks++;
+        }
+        return moved;
+    }
+
+    /**
+     * @brief Carry up to max_bytes in each direction
+     * @return Total characters moved
+     */
+    size_t transfer(size_t max_bytes = BLOCK_SIZE) {
+        return transfer(A_TO_B, max_bytes) + transfer(B_TO_A, max_bytes);
+    }
+
+    /**
+     * @brief Keep transferring until neither side has anything it can send
+     * @return Total characters moved
+     */
+    size_t runToIdle() {
+        size_t total = 0;
+        for (;;) {
+            size_t moved = transfer();
+            if (moved == 0) {
+                return total;
+            }
+            total += moved;
+        }
+    }
+
+    const LinkDirectionStats& getStats(Direction direction) const {
+        return stats[direction];
+    }
+
+    void resetStats() {
+        for (int i = 0; i < 2; i++) {
+            stats[i].bytes = 0;
+            stats[i].blocks = 0;
+            stats[i].stalls = 0;
+            stats[i].dropped = 0;
+        }
+    }
+
+private:
+    Driver& side_a;
+    Driver& side_b;
+    bool flow_control;
+    LinkDirectionStats stats[2];
+};
+
+template <typename Driver>
+constexpr size_t BasicUARTLink<Driver>::BLOCK_SIZE;
+
+typedef BasicUARTLink<UARTDriver> UARTLink;
+
+} // namespace uart
+
+#endif // UART_LINK_H
@@ -0,0 +1,190 @@
+#ifndef UART_MAPPED_REGISTERS_H
+#define UART_MAPPED_REGISTERS_H
+
+#include "uart_registers.h"
+#include <cstdint>
+#include <cstddef>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace uart {
+
+/**
+ * @brief Register backend over a raw block of 32-bit registers
+ *
+ * Drop-in for UARTRegisters as the Registers parameter of BasicUARTDriver:
+ * the same access semantics (masked writes, write-1-to-clear status and
+ * interrupt bits, derived FIFO status bits), but every register lives at
+ * base[offset / 4] in caller-provided memory, such as a co-simulation
+ * window or a RegisterWindow mapped from a file or shared memory.
+ *
+ * Everything is inline and the driver passes constant offsets, so each
+ * register access compiles to a single volatile load or store; sticky
+ * status and interrupt bits are updated with atomic read-modify-writes so
+ * the driver's two sides may set them concurrently. The block must be at
+ * least REGISTER_BLOCK_SIZE bytes and 4-byte aligned.
+ *
+ * The window holds the stored register values. Like UARTRegisters, the FIFO
+ * bits of the status register are combined in on read through the backend
+ * when a status provider is installed.
+ */
+class MappedUARTRegisters {
+public:
+    typedef UARTRegisters::StatusProvider StatusProvider;
+
+    explicit MappedUARTRegisters(volatile uint32_t* block)
+        : base(block)
+        , status_provider(nullptr)
+        , status_context(nullptr) {
+    }
+
+    volatile uint32_t* getBase() const { return base; }
+
+    // Register access
+    void writeRegister(uint32_t offset, uint32_t value) {
+        switch (offset) {
+            case UART_DATA_REG:
+                reg(UART_DATA_REG) = value & 0xFF;  // Only 8 bits for data
+                break;
+            case UART_STATUS_REG:
+                // Only the error bits are writable, and they are W1C
+                atomicAnd(UART_STATUS_REG, ~(value & STATUS_ERROR_MASK));
+                break;
+            case UART_CONTROL_REG:
+            case UART_BAUD_REG:
+                reg(offset) = value;
+                break;
+            case UART_FIFO_CTRL_REG:
+                reg(UART_FIFO_CTRL_REG) = value & (FCR_RX_TRIG_MASK | FCR_TX_LOW_MASK);
+                break;
+            case UART_INT_ENABLE_REG:
+                reg(UART_INT_ENABLE_REG) = value & (INT_RX_TRIGGER | INT_TX_LOW | INT_LINE_ERROR);
+                break;
+            case UART_INT_STATUS_REG:
+                atomicAnd(UART_INT_STATUS_REG, ~value);
+                break;
+            default:
+                break;
+        }
+    }
+
+    uint32_t readRegister(uint32_t offset) const {
+        if (offset == UART_STATUS_REG) {
+            return readStatus();
+        }
+        if (offset > UART_INT_STATUS_REG || (offset & 3) != 0) {
+            return 0;  // Invalid register reads return 0
+        }
+        return reg(offset);
+    }
+
+    // Direct status flag access for internal use
+    void setStatusBit(uint32_t bit) { atomicOr(UART_STATUS_REG, bit); }
+    void clearStatusBit(uint32_t bit) { atomicAnd(UART_STATUS_REG, ~bit); }
+
+    bool isStatusBitSet(uint32_t bit) const {
+        if ((bit & STATUS_FIFO_MASK) == 0) {
+            return (reg(UART_STATUS_REG) & bit) != 0;
+        }
+        return (readStatus() & bit) != 0;
+    }
+
+    void setStatusProvider(StatusProvider provider, const void* context) {
+        status_provider = provider;
+        status_context = context;
+    }
+
+    // Control register queries
+    bool isEnabled() const { return (reg(UART_CONTROL_REG) & CTRL_ENABLE) != 0; }
+    bool isTxEnabled() const { return (reg(UART_CONTROL_REG) & CTRL_TX_ENABLE) != 0; }
+    bool isRxEnabled() const { return (reg(UART_CONTROL_REG) & CTRL_RX_ENABLE) != 0; }
+    bool isParityEnabled() const { return (reg(UART_CONTROL_REG) & CTRL_PARITY_EN) != 0; }
+    bool isParityOdd() const { return (reg(UART_CONTROL_REG) & CTRL_PARITY_ODD) != 0; }
+    bool isTwoStopBits() const { return (reg(UART_CONTROL_REG) & CTRL_TWO_STOP) != 0; }
+    uint32_t getBaudRate() const { return reg(UART_BAUD_REG); }
+
+    // Interrupt state
+    void setInterruptPending(uint32_t bits) { atomicOr(UART_INT_STATUS_REG, bits); }
+    uint32_t getInterruptPending() const { return reg(UART_INT_STATUS_REG); }
+    uint32_t getInterruptEnable() const { return reg(UART_INT_ENABLE_REG); }
+    uint32_t getFifoControl() const { return reg(UART_FIFO_CTRL_REG); }
+
+    // Reset to power-on state
+    void reset() {
+        reg(UART_DATA_REG) = 0;
+        reg(UART_STATUS_REG) = STATUS_TX_EMPTY | STATUS_RX_EMPTY;
+        reg(UART_CONTROL_REG) = 0;
+        reg(UART_BAUD_REG) = 0;
+        reg(UART_FIFO_CTRL_REG) = 0;
+        reg(UART_INT_ENABLE_REG) = 0;
+        reg(UART_INT_STATUS_REG) = 0;
+    }
+
+private:
+    volatile uint32_t* base;
+    StatusProvider status_provider;
+    const void* status_context;
+
+    volatile uint32_t& reg(uint32_t offset) const {
+        return base[offset / sizeof(uint32_t)];
+    }
+
+    uint32_t readStatus() const {
+        uint32_t status = reg(UART_STATUS_REG);
+        if (status_provider) {
+            status = (status & ~STATUS_FIFO_MASK) | status_provider(status_context);
+        }
+        return status;
+    }
+
+    void atomicOr(uint32_t offset, uint32_t bits) {
+#if defined(__GNUC__)
+        __atomic_fetch_or(&reg(offset), bits, __ATOMIC_RELAXED);
+#elif defined(_MSC_VER)
+        _InterlockedOr(reinterpret_cast<volatile long*>(&reg(offset)), static_cast<long>(bits));
+#else
+        reg(offset) |= bits;
+#endif
+    }
+
+    void atomicAnd(uint32_t offset, uint32_t bits) {
+#if defined(__GNUC__)
+        __atomic_fetch_and(&reg(offset), bits, __ATOMIC_RELAXED);
+#elif defined(_MSC_VER)
+        _InterlockedAnd(reinterpret_cast<volatile long*>(&reg(offset)), static_cast<long>(bits));
+#else
+        reg(offset) &= bits;
+#endif
+    }
+};
+
+/**
+ * @brief A register block mapped from a file or shared-memory object
+ *
+ * open() maps REGISTER_BLOCK_SIZE bytes of the file at path read-write and
+ * shared, creating and sizing the file if needed, so every process that
+ * maps the same path (for example under /dev/shm) sees the same registers.
+ * Mapping is available on POSIX systems; elsewhere open() returns false.
+ */
+class RegisterWindow {
+public:
+    RegisterWindow();
+    ~RegisterWindow();
+
+    bool open(const char* path);
+    void close();
+
+    volatile uint32_t* get() const { return base; }
+
+private:
+    volatile uint32_t* base;
+
+    RegisterWindow(const RegisterWindow&) = delete;
+    RegisterWindow& operator=(const RegisterWindow&) = delete;
+};
+
+} // namespace uart
+
+#endif // UART_MAPPED_REGISTERS_H
@@ -0,0 +1,158 @@
+#ifndef UART_PARITY_H
+#define UART_PARITY_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+namespace uart {
+
+/**
+ * @brief Block parity kernels
+ *
+ * Parity bits are packed one per character, LSB first: bit (i % 8) of
+ * parity_bits[i / 8] belongs to data[i]. Even parity sets the bit when the
+ * data byte has an odd number of ones, so the character as a whole has an
+ * even count; odd parity is the complement.
+ *
+ * The kernels work on eight bytes at a time inside a 64-bit word (SWAR):
+ * three shift/xor folds leave each byte's parity in its low bit, and one
+ * multiply gathers the eight bits into an output byte. There are no
+ * per-byte branches or table lookups, so the cost is a few instructions per
+ * eight characters.
+ */
+
+/**
+ * @brief Number of bytes needed to hold parity bits for length characters
+ */
+inline size_t parityMaskBytes(size_t length) {
+    return (length + 7) / 8;
+}
+
+// Number of set bits in a byte
+inline size_t countBits8(uint8_t bits) {
+#if defined(__GNUC__)
+    return static_cast<size_t>(__builtin_popcount(bits));
+#else
+    size_t count = 0;
+    for (; bits; bits &= bits - 1) {
+        count++;
+    }
+    return count;
+#endif
+}
+
+// Parity of each of up to eight bytes (zero padded), packed LSB first
+inline uint8_t parityOf8(const uint8_t* data, size_t count) {
+    uint64_t word = 0;
+    memcpy(&word, data, count);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    word = __builtin_bswap64(word);
+#endif
+    word ^= word >> 4;
+    word ^= word >> 2;
+    word ^= word >> 1;
+    word &= 0x0101010101010101ULL;
+    // Byte k's bit lands on bit 56 + k
+    return static_cast<uint8_t>((word * 0x0102040810204080ULL) >> 56);
+}
+
+/**
+ * @brief Generate parity bits for a block of characters
+ * @param parity_bits Output, parityMaskBytes(length) bytes
+ */
+inline void computeParityBits(const uint8_t* data, size_t length, bool odd, uint8_t* parity_bits) {
+    const uint8_t flip = odd ? 0xFF : 0x00;
+    size_t full = length / 8;
+    for (size_t i = 0; i < full; i++) {
+        parity_bits[i] = parityOf8(data + i * 8, 8) ^ flip;
+    }
+    size_t rest = length % 8;
+    if (rest) {
+        uint8_t valid = static_cast<uint8_t>((1u << rest) - 1);
+        parity_bits[full] = (parityOf8(data + full * 8, rest) ^ flip) & valid;
+    }
+}
+
+/**
+ * @brief Check received parity bits against the data
+ * @param error_mask Output, parityMaskBytes(length) bytes with a bit set for
+ *                   each character that failed; may be nullptr
+ * @return Number of characters with a parity error
+ */
+inline size_t checkParityBits(const uint8_t* data, size_t length, bool odd,
+                              const uint8_t* parity_bits, uint8_t* error_mask) {
+    const uint8_t flip = odd ? 0xFF : 0x00;
+    size_t errors = 0;
+    size_t words = parityMaskBytes(length);
+    for (size_t i = 0; i < words; i++) {
+        size_t count = (i * 8 + 8 <= length) ? 8 : length - i * 8;
+        uint8_t valid = (count == 8) ? 0xFF : static_cast<uint8_t>((1u << count) - 1);
+        uint8_t bad = (parityOf8(data + i * 8, count) ^ flip ^ parity_bits[i]) & valid;
+        if (error_mask) {
+            error_mask[i] = bad;
+        }
+        errors += countBits8(bad);
+    }
+    return errors;
+}
+
+/**
+ * @brief Count parity errors in part of a received block
+ * @param parity_bits Parity bits of the whole block
+ * @param bit_offset Index of data[0] within the block, so its parity bit is
+ *                   bit (bit_offset % 8) of parity_bits[bit_offset / 8]
+ * @return Number of characters in data[0, length) with a parity error
+ */
+inline size_t countParityErrors(const uint8_t* data, size_t length, bool odd,
+                                const uint8_t* parity_bits, size_t bit_offset) {
+    const uint8_t flip = odd ? 0xFF : 0x00;
+    const uint8_t* bits = parity_bits + bit_offset / 8;
+    const unsigned shift = static_cast<unsigned>(bit_offset % 8);
+    size_t errors = 0;
+    for (size_t i = 0; i < length; i += 8) {
+        size_t count = (length - i < 8) ? length - i : 8;
+        size_t k = i / 8;
+        // Realign the eight parity bits; the next byte only if they straddle it
+        unsigned expected = bits[k] >> shift;
+        if (shift + count > 8) {
+            expected |= static_cast<unsigned>(bits[k + 1]) << (8 - shift);
+        }
+        uint8_t valid = (count == 8) ? 0xFF : static_cast<uint8_t>((1u << count) - 1);
+        uint8_t bad = (parityOf8(data + i, count) ^ flip ^ static_cast<uint8_t>(expected)) & valid;
+        errors += countBits8(bad);
+    }
+    return errors;
+}
+
+/**
+ * @brief Count the set bits in [bit_offset, bit_offset + count) of a mask
+ */
+inline size_t countMaskBits(const uint8_t* mask, size_t bit_offset, size_t count) {
+    size_t errors = 0;
+    size_t end = bit_offset + count;
+    for (size_t i = bit_offset; i < end;) {
+        unsigned shift = static_cast<unsigned>(i % 8);
+        size_t take = (8 - shift < end - i) ? 8 - shift : end - i;
+        errors += countBits8(static_cast<uint8_t>((mask[i / 8] >> shift) & ((1u << take) - 1)));
+        i += take;
+    }
+    return errors;
+}
+
+/**
+ * @brief Clear the bits [bit_offset, bit_offset + count) of a mask
+ */
+inline void clearMaskBits(uint8_t* mask, size_t bit_offset, size_t count) {
+    size_t end = bit_offset + count;
+    for (size_t i = bit_offset; i < end;) {
+        unsigned shift = static_cast<unsigned>(i % 8);
+        size_t take = (8 - shift < end - i) ? 8 - shift : end - i;
+        mask[i / 8] &= static_cast<uint8_t>(~(((1u << take) - 1) << shift));
+        i += take;
+    }
+}
+
+} // namespace uart
+
+#endif // UART_PARITY_H
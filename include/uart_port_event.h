@@ -0,0 +1,25 @@
+#ifndef UART_PORT_EVENT_H
+#define UART_PORT_EVENT_H
+
+#include <cstdint>
+#include <cstddef>
+
+namespace uart {
+
+// Port readiness events
+constexpr uint32_t HUB_READABLE = (1 << 0);  // RX data available
+constexpr uint32_t HUB_WRITABLE = (1 << 1);  // TX space available
+constexpr uint32_t HUB_ERROR    = (1 << 2);  // Overrun or frame error latched
+
+/**
+ * @brief One ready port reported by BasicUARTHub::poll() or
+ *        BasicUARTPortTable::poll()
+ */
+struct PortEvent {
+    size_t port;
+    uint32_t events;
+};
+
+} // namespace uart
+
+#endif // UART_PORT_EVENT_H
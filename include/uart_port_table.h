@@ -0,0 +1,346 @@
+#ifndef UART_PORT_TABLE_H
+#define UART_PORT_TABLE_H
+
+#include "uart_port_event.h"
+#include "uart_registers.h"
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+namespace uart {
+
+/**
+ * @brief Dense table of many simulated UART ports
+ *
+ * A BasicUARTDriver carries its own register block, atomic ring indices and
+ * padding, which is the right shape for one port shared by two threads but
+ * scatters the state of tens of thousands of ports over cold memory. This
+ * table stores the same ports as parallel arrays instead: one byte of
+ * control and sticky error bits per port, FIFO counts and read indices in the
+ * narrowest type that holds Depth, and all FIFO storage in one contiguous
+ * slab (port i's TX ring, then its RX ring). Status words are derived from
+ * the counts on read, as the driver's status provider does.
+ *
+ * scanReady() computes readiness (HUB_READABLE, HUB_WRITABLE, HUB_ERROR) for
+ * a run of ports from the control, error, interest and count arrays alone,
+ * as a branch-free loop the compiler vectorizes; with Depth <= 128 that is a
+ * few cache lines per hundred ports. poll() runs the scan in blocks and
+ * skips idle ports eight at a time.
+ *
+ * The table has no internal synchronization: the application and device
+ * side of every port run on the thread that owns the table, as in an event
+ * loop that services all ports. Depth must be a power of two up to 32768.
+ */
+template <size_t Depth>
+class BasicUARTPortTable {
+public:
+    static_assert(Depth >= 2 && (Depth & (Depth - 1)) == 0, "FIFO depth must be a power of two");
+    static_assert(Depth <= 32768, "FIFO depth must fit a 16-bit count");
+
+    // FIFO counts and indices: one byte while a count of Depth still fits
+    typedef typename std::conditional<(Depth < 256), uint8_t, uint16_t>::type Count;
+
+    static constexpr size_t FIFO_DEPTH = Depth;
+
+    // Ports examined per scanReady() block inside poll()
+    static constexpr size_t SCAN_BLOCK = 256;
+
+    explicit BasicUARTPortTable(size_t num_ports)
+        : num_ports(num_ports)
+        , control(new uint8_t[num_ports]())
+        , errors(new uint8_t[num_ports]())
+        , interest(new uint8_t[num_ports])
+        , tx_count(new Count[num_ports]())
+        , rx_count(new Count[num_ports]())
+        , tx_head(new Count[num_ports]())
+        , rx_head(new Count[num_ports]())
+        , baud(new uint32_t[num_ports]())
+        , slab(new uint8_t[num_ports * 2 * Depth]) {
+        memset(interest.get(), HUB_READABLE, num_ports);
+    }
+
+    size_t size() const { return num_ports; }
+
+    /**
+     * @brief Bytes of table state per port, FIFO storage included
+     */
+    static constexpr size_t bytesPerPort() {
+        return 3 * sizeof(uint8_t) + 4 * sizeof(Count) + sizeof(uint32_t) + 2 * Depth;
+    }
+
+    /**
+     * @brief Reset and enable one port (see BasicUARTDriver::initialize)
+     */
+    bool initialize(size_t port, uint32_t baud_rate, bool enable_parity = false, bool odd_parity = false,
+                    bool two_stop_bits = false) {
+        uint8_t ctrl = CTRL_ENABLE | CTRL_TX_ENABLE | CTRL_RX_ENABLE;
+        if (enable_parity) {
+            ctrl |= CTRL_PARITY_EN;
+            if (odd_parity) {
+                ctrl |= CTRL_PARITY_ODD;
+            }
+        }
+        if (two_stop_bits) {
+            ctrl |= CTRL_TWO_STOP;
+        }
+        control[port] = ctrl;
+        baud[port] = baud_rate;
+        resetPort(port);
+        return true;
+    }
+
+    /**
+     * @brief Initialize every port with the same configuration
+     */
+    bool initializeAll(uint32_t baud_rate, bool enable_parity = false, bool odd_parity = false) {
+        bool ok = true;
+        for (size_t i = 0; i < num_ports; i++) {
+            ok = initialize(i, baud_rate, enable_parity, odd_parity) && ok;
+        }
+        return ok;
+    }
+
+    void shutdown(size_t port) {
+        control[port] = 0;
+        resetPort(port);
+    }
+
+    /**
+     * @brief Select the HUB_* events scanReady() and poll() report for a port
+     */
+    void setInterest(size_t port, uint32_t events) {
+        interest[port] = static_cast<uint8_t>(events & (HUB_READABLE | HUB_WRITABLE | HUB_ERROR));
+    }
+
+    // Application side
+
+    bool writeByte(size_t port, uint8_t data) {
+        return writeData(port, &data, 1) == 1;
+    }
+
+    size_t writeData(size_t port, const uint8_t* data, size_t length) {
+        if (!data || !(control[port] & CTRL_TX_ENABLE)) {
+            return 0;
+        }
+        size_t count = tx_count[port];
+        size_t n = (length < Depth - count) ? length : Depth - count;
+        copyIn(txRing(port), (tx_head[port] + count) & MASK, data, n);
+        tx_count[port] = static_cast<Count>(count + n);
+        return n;
+    }
+
+    bool readByte(size_t port, uint8_t& data) {
+        return readData(port, &data, 1) == 1;
+    }
+
+    size_t readData(size_t port, uint8_t* buffer, size_t max_length) {
+        if (!buffer || !(control[port] & CTRL_RX_ENABLE)) {
+            return 0;
+        }
+        size_t n = (max_length < rx_count[port]) ? max_length : rx_count[port];
+        copyOut(buffer, rxRing(port), rx_head[port], n);
+        rx_head[port] = static_cast<Count>((rx_head[port] + n) & MASK);
+        rx_count[port] = static_cast<Count>(rx_count[port] - n);
+        return n;
+    }
+
+    // Device side
+
+    /**
+     * @brief Deliver line data to a port's RX FIFO
+     * Bytes that do not fit are dropped and latch STATUS_OVERRUN.
+     * @return Bytes accepted and dropped, as BasicUARTDriver::simulateReceive
+     */
+    ReceiveResult simulateReceive(size_t port, const uint8_t* data, size_t length) {
+        ReceiveResult result = {0, data ? length : 0};
+        if (!data || !(control[port] & CTRL_RX_ENABLE)) {
+            return result;
+        }
+        size_t count = rx_count[port];
+        size_t n = (length < Depth - count) ? length : Depth - count;
+        copyIn(rxRing(port), (rx_head[port] + count) & MASK, data, n);
+        rx_count[port] = static_cast<Count>(count + n);
+        if (n < length) {
+            errors[port] |= STATUS_OVERRUN;
+        }
+        result.accepted = n;
+        result.dropped = length - n;
+        return result;
+    }
+
+    /**
+     * @brief Transmit up to num_bytes characters, copying them to out if given
+     * A port whose transmitter is disabled sends nothing.
+     * @return Characters transmitted
+     */
+    size_t drainTx(size_t port, uint8_t* out, size_t num_bytes) {
+        if (!(control[port] & CTRL_TX_ENABLE)) {
+            return 0;
+        }
+        size_t n = (num_bytes < tx_count[port]) ? num_bytes : tx_count[port];
+        if (out) {
+            copyOut(out, txRing(port), tx_head[port], n);
+        }
+        tx_head[port] = static_cast<Count>((tx_head[port] + n) & MASK);
+        tx_count[port] = static_cast<Count>(tx_count[port] - n);
+        return n;
+    }
+
+    size_t simulateTransmit(size_t port, size_t num_bytes) {
+        return drainTx(port, nullptr, num_bytes);
+    }
+
+    // Status
+
+    size_t getTxFifoCount(size_t port) const { return tx_count[port]; }
+    size_t getRxFifoCount(size_t port) const { return rx_count[port]; }
+
+    bool canTransmit(size_t port) const {
+        return (control[port] & CTRL_TX_ENABLE) && tx_count[port] < Depth;
+    }
+
+    bool hasData(size_t port) const {
+        return (control[port] & CTRL_RX_ENABLE) && rx_count[port] > 0;
+    }
+
+    bool hasError(size_t port) const { return errors[port] != 0; }
+
+    void clearErrors(size_t port) { errors[port] = 0; }
+
+    void setFrameError(size_t port) { errors[port] |= STATUS_FRAME_ERR; }
+
+    uint32_t readStatus(size_t port) const {
+        uint32_t status = errors[port];
+        status |= (tx_count[port] == 0) ? STATUS_TX_EMPTY : 0;
+        status |= (tx_count[port] == Depth) ? STATUS_TX_FULL : 0;
+        status |= (rx_count[port] == 0) ? STATUS_RX_EMPTY : 0;
+        status |= (rx_count[port] == Depth) ? STATUS_RX_FULL : 0;
+        return status;
+    }
+
+    uint32_t readControl(size_t port) const { return control[port]; }
+    uint32_t getBaudRate(size_t port) const { return baud[port]; }
+
+    /**
+     * @brief Compute the ready HUB_* events of ports [first, first + count)
+     * @param ready One byte per port, 0 when the port needs no service
+     */
+    void scanReady(size_t first, size_t count, uint8_t* ready) const {
+        const uint8_t* ctrl = control.get() + first;
+        const uint8_t* err = errors.get() + first;
+        const uint8_t* want = interest.get() + first;
+        const Count* txc = tx_count.get() + first;
+        const Count* rxc = rx_count.get() + first;
+        for (size_t i = 0; i < count; i++) {
+            uint8_t rx_on = static_cast<uint8_t>((ctrl[i] >> RX_ENABLE_SHIFT) & 1);
+            uint8_t tx_on = static_cast<uint8_t>((ctrl[i] >> TX_ENABLE_SHIFT) & 1);
+            uint8_t readable = static_cast<uint8_t>(rx_on & (rxc[i] != 0));
+            uint8_t writable = static_cast<uint8_t>(tx_on & (txc[i] != Depth));
+            uint8_t failed = static_cast<uint8_t>(err[i] != 0);
+            ready[i] = static_cast<uint8_t>((readable * HUB_READABLE | writable * HUB_WRITABLE |
+                                             failed * HUB_ERROR) & want[i]);
+        }
+    }
+
+    /**
+     * @brief Collect ready ports in index order
+     * @return Number of entries written to events
+     */
+    size_t poll(PortEvent* events, size_t max_events) const {
+        uint8_t ready[SCAN_BLOCK];
+        size_t found = 0;
+        for (size_t first = 0; first < num_ports && found < max_events; first += SCAN_BLOCK) {
+            size_t count = (num_ports - first < SCAN_BLOCK) ? num_ports - first : SCAN_BLOCK;
+            scanReady(first, count, ready);
+            for (size_t i = 0; i < count && found < max_events; i += 8) {
+                size_t span = (count - i < 8) ? count - i : 8;
+                uint64_t word = 0;
+                memcpy(&word, ready + i, span);
+                if (word == 0) {
+                    continue;
+                }
+                for (size_t j = 0; j < span && found < max_events; j++) {
+                    if (ready[i + j]) {
+                        events[found].port = first + i + j;
+                        events[found].events = ready[i + j];
+                        found++;
+                    }
+                }
+            }
+        }
+        return found;
+    }
+
+private:
+    static constexpr size_t MASK = Depth - 1;
+    static constexpr unsigned RX_ENABLE_SHIFT = 2;  // CTRL_RX_ENABLE
+    static constexpr unsigned TX_ENABLE_SHIFT = 1;  // CTRL_TX_ENABLE
+
+    size_t num_ports;
+
+    // Hot: read by every readiness scan
+    std::unique_ptr<uint8_t[]> control;    // Low byte of the control register
+    std::unique_ptr<uint8_t[]> errors;     // Sticky STATUS_ERROR_MASK bits
+    std::unique_ptr<uint8_t[]> interest;   // HUB_* events of interest
+    std::unique_ptr<Count[]> tx_count;
+    std::unique_ptr<Count[]> rx_count;
+
+    // Warm: touched only when a port moves data
+    std::unique_ptr<Count[]> tx_head;      // Oldest TX character
+    std::unique_ptr<Count[]> rx_head;      // Oldest RX character
+    std::unique_ptr<uint32_t[]> baud;
+    std::unique_ptr<uint8_t[]> slab;       // Per port: TX ring, then RX ring
+
+    static_assert(CTRL_RX_ENABLE == (1u << RX_ENABLE_SHIFT), "RX enable bit moved");
+    static_assert(CTRL_TX_ENABLE == (1u << TX_ENABLE_SHIFT), "TX enable bit moved");
+
+    uint8_t* txRing(size_t port) { return slab.get() + port * 2 * Depth; }
+    uint8_t* rxRing(size_t port) { return slab.get() + port * 2 * Depth + Depth; }
+
+    void resetPort(size_t port) {
+        errors[port] = 0;
+        tx_count[port] = 0;
+        rx_count[port] = 0;
+        tx_head[port] = 0;
+        rx_head[port] = 0;
+    }
+
+    // Ring copies split at the wrap point: at most two memcpy calls
+    static void copyIn(uint8_t* ring, size_t pos, const uint8_t* data, size_t n) {
+        size_t first = (n < Depth - pos) ? n : Depth - pos;
+        memcpy(ring + pos, data, first);
+        memcpy(ring, data + first, n - first);
+    }
+
+    static void copyOut(uint8_t* out, const uint8_t* ring, size_t pos, size_t n) {
+        size_t first = (n < Depth - pos) ? n : Depth - pos;
+        memcpy(out, ring + pos, first);
+        memcpy(out + first, ring, n - first);
+    }
+
+    BasicUARTPortTable(const BasicUARTPortTable&) = delete;
+    BasicUARTPortTable& operator=(const BasicUARTPortTable&) = delete;
+};
+
+template <size_t Depth>
+constexpr size_t BasicUARTPortTable<Depth>::FIFO_DEPTH;
+
+template <size_t Depth>
+constexpr size_t BasicUARTPortTable<Depth>::SCAN_BLOCK;
+
+template <size_t Depth>
+constexpr size_t BasicUARTPortTable<Depth>::MASK;
+
+template <size_t Depth>
+constexpr unsigned BasicUARTPortTable<Depth>::RX_ENABLE_SHIFT;
+
+template <size_t Depth>
+constexpr unsigned BasicUARTPortTable<Depth>::TX_ENABLE_SHIFT;
+
+typedef BasicUARTPortTable<FIFO_DEPTH> UARTPortTable;
+
+} // namespace uart
+
+#endif // UART_PORT_TABLE_H
@@ -0,0 +1,386 @@
+#ifndef UART_PTY_H
+#define UART_PTY_H
+
+#include "uart_driver.h"
+#include <cstdint>
+#include <cstddef>
+
+#if defined(__linux__)
+
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <memory>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <termios.h>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+namespace uart {
+
+/**
+ * @brief Counters for a BasicUARTPty backend
+ */
+struct PtyStats {
+    uint64_t bytes_in;     // Bytes read from PTY masters into the drivers
+    uint64_t bytes_out;    // Bytes written from the drivers to PTY masters
+    uint64_t reads;        // read() calls that returned data
+    uint64_t writes;       // write() calls that accepted data
+    uint64_t wakeups;      // epoll_wait() calls that returned events
+    uint64_t kicks;        // wake() signals consumed by poll()
+};
+
+/**
+ * @brief Exposes drivers as Linux pseudo-terminals (/dev/pts/N)
+ *
+ * Each port gets a PTY pair. Bytes a tool writes to the slave (minicom,
+ * pyserial, ...) arrive at the master and are fed to simulateReceive();
+ * characters the driver transmits are taken with drainTx() and written to
+ * the master, where the tool reads them. The slave is put in raw mode and a
+ * slave descriptor is held open so the master never sees a hangup when a
+ * tool disconnects.
+ *
+ * All masters are nonblocking and registered with one epoll set, so a single
+ * thread calling poll() serves every port. Reads and writes move up to
+ * IO_BLOCK bytes per system call. Input is only read while the driver's
+ * receive path has room; otherwise it stays in the kernel's PTY buffer,
+ * which pushes back on the writer instead of overrunning the UART. Output
+ * the master cannot take yet is staged per port and retried on EPOLLOUT.
+ *
+ * poll() is the device side of every attached driver; the application side
+ * of each driver may run on other threads. The driver has no callback for
+ * application writes, so those threads call wake(index) after queueing TX
+ * data or freeing RX space. That marks the port in a bitmap and signals an
+ * eventfd in the epoll set; poll() then services only the marked ports, so
+ * the cost of a wakeup does not grow with the number of idle ports.
+ */
+template <typename Driver>
+class BasicUARTPty {
+public:
+    // Bytes moved per read()/write() call
+    static constexpr size_t IO_BLOCK = 4096;
+
+    BasicUARTPty()
+        : epoll_fd(epoll_create1(EPOLL_CLOEXEC))
+        , wake_fd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+        , woken_words(0) {
+        resetStats();
+        struct epoll_event event;
+        memset(&event, 0, sizeof(event));
+        event.events = EPOLLIN;
+        event.data.u64 = WAKE_TOKEN;
+        if (epoll_fd >= 0 && (wake_fd < 0 || epoll_ctl(epoll_fd, EPOLL_CTL_ADD, wake_fd, &event) != 0)) {
+            close(epoll_fd);
+            epoll_fd = -1;
+        }
+    }
+
+    ~BasicUARTPty() {
+        for (size_t i = 0; i < ports.size(); i++) {
+            close(ports[i]->master);
+            close(ports[i]->slave);
+        }
+        if (epoll_fd >= 0) {
+            close(epoll_fd);
+        }
+        if (wake_fd >= 0) {
+            close(wake_fd);
+        }
+    }
+
+    /**
+     * @brief Create a PTY for a driver
+     * Not concurrent with poll() or wake().
+     * @return Port index, or -1 if the PTY could not be created
+     */
+    int addPort(Driver& uart) {
+        if (epoll_fd < 0) {
+            return -1;
+        }
+        int master = posix_openpt(O_RDWR | O_NOCTTY | O_CLOEXEC);
+        if (master < 0) {
+            return -1;
+        }
+        std::unique_ptr<Port> port(new Port(uart, master));
+        if (grantpt(master) != 0 || unlockpt(master) != 0 ||
+            ptsname_r(master, port->path, sizeof(port->path)) != 0) {
+            close(master);
+            return -1;
+        }
+
+        port->slave = open(port->path, O_RDWR | O_NOCTTY | O_CLOEXEC);
+        if (port->slave < 0) {
+            close(master);
+            return -1;
+        }
+        struct termios tio;
+        if (tcgetattr(port->slave, &tio) == 0) {
+            cfmakeraw(&tio);
+            tcsetattr(port->slave, TCSANOW, &tio);
+        }
+
+        int flags = fcntl(master, F_GETFL);
+        if (flags < 0 || fcntl(master, F_SETFL, flags | O_NONBLOCK) < 0) {
+            close(port->slave);
+            close(master);
+            return -1;
+        }
+
+        struct epoll_event event;
+        memset(&event, 0, sizeof(event));
+        event.events = EPOLLIN;
+        event.data.u64 = ports.size();
+        if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, master, &event) != 0) {
+            close(port->slave);
+            close(master);
+            return -1;
+        }
+
+        ports.push_back(std::move(port));
+        growWoken();
+        return static_cast<int>(ports.size() - 1);
+    }
+
+    size_t size() const { return ports.size(); }
+
+    /**
+     * @brief Slave device path for a port, e.g. "/dev/pts/3"
+     */
+    const char* getPath(size_t index) const { return ports[index]->path; }
+
+    int getMasterFd(size_t index) const { return ports[index]->master; }
+
+    /**
+     * @brief Move data between the drivers and their PTYs
+     * @param timeout_ms Longest wait for PTY activity or a wake()
+     *                   (0 = don't block, -1 = forever)
+     * @return Bytes moved in either direction
+     */
+    size_t poll(int timeout_ms) {
+        size_t moved = 0;
+        struct epoll_event events[MAX_EVENTS];
+        int count = epoll_wait(epoll_fd, events, MAX_EVENTS, timeout_ms);
+        if (count <= 0) {
+            return 0;
+        }
+        stats.wakeups++;
+        for (int e = 0; e < count; e++) {
+            if (events[e].data.u64 == WAKE_TOKEN) {
+                uint64_t kicks = 0;
+                if (read(wake_fd, &kicks, sizeof(kicks)) == static_cast<ssize_t>(sizeof(kicks))) {
+                    stats.kicks += kicks;
+                }
+                moved += serviceWoken();
+                continue;
+            }
+            size_t index = static_cast<size_t>(events[e].data.u64);
+            if (events[e].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+                moved += readInput(index);
+            }
+            if (events[e].events & EPOLLOUT) {
+                moved += flushOutput(index);
+            }
+            updateEvents(index);
+        }
+        return moved;
+    }
+
+    /**
+     * @brief Have a blocked or upcoming poll() service one port
+     * Application side; safe from any thread. Call it after writing TX data
+     * or reading RX data, which poll() cannot otherwise see: queued output
+     * is flushed and input paused for lack of RX space is resumed.
+     */
+    void wake(size_t index) {
+        uint64_t bit = static_cast<uint64_t>(1) << (index % 64);
+        if (woken[index / 64].fetch_or(bit, std::memory_order_acq_rel) & bit) {
+            return;  // Already marked; its eventfd signal is still pending
+        }
+        uint64_t one = 1;
+        ssize_t n = write(wake_fd, &one, sizeof(one));
+        (void)n;  // EAGAIN: counter saturated, a wakeup is already pending
+    }
+
+    const PtyStats& getStats() const { return stats; }
+
+    void resetStats() {
+        stats.bytes_in = 0;
+        stats.bytes_out = 0;
+        stats.reads = 0;
+        stats.writes = 0;
+        stats.wakeups = 0;
+        stats.kicks = 0;
+    }
+
+private:
+    static constexpr int MAX_EVENTS = 64;
+    // epoll data for the wake eventfd; port indices never reach it
+    static constexpr uint64_t WAKE_TOKEN = ~static_cast<uint64_t>(0);
+
+    struct Port {
+        Port(Driver& driver, int master_fd)
+            : uart(driver)
+            , master(master_fd)
+            , slave(-1)
+            , out(new uint8_t[IO_BLOCK])
+            , out_start(0)
+            , out_end(0)
+            , rx_paused(false)
+            , tx_waiting(false)
+            , armed_events(EPOLLIN) {
+            path[0] = '\0';
+        }
+
+        Driver& uart;
+        int master;
+        int slave;                       // Held open so the master never hangs up
+        char path[64];
+        std::unique_ptr<uint8_t[]> out;  // Drained characters not yet written
+        size_t out_start;
+        size_t out_end;
+        bool rx_paused;                  // Driver RX full; input left in the kernel
+        bool tx_waiting;                 // Master full; waiting for EPOLLOUT
+        uint32_t armed_events;
+    };
+
+    int epoll_fd;
+    int wake_fd;
+    std::vector<std::unique_ptr<Port> > ports;
+    std::unique_ptr<std::atomic<uint64_t>[]> woken;  // One bit per port marked by wake()
+    size_t woken_words;
+    PtyStats stats;
+
+    // Keep one bitmap bit per port; addPort() runs with no wake() in flight
+    void growWoken() {
+        if (ports.size() <= woken_words * 64) {
+            return;
+        }
+        size_t words = woken_words ? woken_words * 2 : 1;
+        std::unique_ptr<std::atomic<uint64_t>[]> grown(new std::atomic<uint64_t>[words]);
+        for (size_t w = 0; w < words; w++) {
+            grown[w].store(w < woken_words ? woken[w].load(std::memory_order_relaxed) : 0,
+                           std::memory_order_relaxed);
+        }
+        woken = std::move(grown);
+        woken_words = words;
+    }
+
+    // Flush queued output and resume paused input on the ports wake() marked
+    size_t serviceWoken() {
+        size_t moved = 0;
+        for (size_t w = 0; w < woken_words; w++) {
+            uint64_t bits = woken[w].exchange(0, std::memory_order_acq_rel);
+            while (bits) {
+                size_t index = w * 64 + static_cast<size_t>(__builtin_ctzll(bits));
+                bits &= bits - 1;
+                Port& port = *ports[index];
+                moved += flushOutput(index);
+                if (port.rx_paused && port.uart.getRxSpace() > 0) {
+                    port.rx_paused = false;
+                    moved += readInput(index);
+                    updateEvents(index);
+                }
+            }
+        }
+        return moved;
+    }
+
+    // PTY input -> simulateReceive, bounded by the driver's receive space
+    size_t readInput(size_t index) {
+        Port& port = *ports[index];
+        uint8_t buffer[IO_BLOCK];
+        size_t total = 0;
+        for (;;) {
+            size_t space = port.uart.getRxSpace();
+            if (space == 0) {
+                port.rx_paused = true;
+                break;
+            }
+            size_t want = (space < IO_BLOCK) ? space : IO_BLOCK;
+            ssize_t n = read(port.master, buffer, want);
+            if (n <= 0) {
+                break;  // EAGAIN: drained; EIO: no slave activity
+            }
+            port.uart.simulateReceive(buffer, static_cast<size_t>(n));
+            total += static_cast<size_t>(n);
+            stats.reads++;
+            stats.bytes_in += static_cast<uint64_t>(n);
+            if (static_cast<size_t>(n) < want) {
+                break;
+            }
+        }
+        return total;
+    }
+
+    // drainTx -> PTY output, staging whatever the master cannot take yet
+    size_t flushOutput(size_t index) {
+        Port& port = *ports[index];
+        size_t total = 0;
+        for (;;) {
+            if (port.out_start == port.out_end) {
+                port.out_start = 0;
+                port.out_end = port.uart.drainTx(port.out.get(), IO_BLOCK);
+                if (port.out_end == 0) {
+                    port.tx_waiting = false;
+                    break;
+                }
+            }
+            ssize_t n = write(port.master, port.out.get() + port.out_start, port.out_end - port.out_start);
+            if (n < 0) {
+                port.tx_waiting = (errno == EAGAIN || errno == EWOULDBLOCK);
+                break;
+            }
+            port.out_start += static_cast<size_t>(n);
+            total += static_cast<size_t>(n);
+            stats.writes++;
+            stats.bytes_out += static_cast<uint64_t>(n);
+        }
+        updateEvents(index);
+        return total;
+    }
+
+    void updateEvents(size_t index) {
+        Port& port = *ports[index];
+        uint32_t wanted = 0;
+        if (!port.rx_paused) {
+            wanted |= EPOLLIN;
+        }
+        if (port.tx_waiting) {
+            wanted |= EPOLLOUT;
+        }
+        if (wanted == port.armed_events) {
+            return;
+        }
+        struct epoll_event event;
+        memset(&event, 0, sizeof(event));
+        event.events = wanted;
+        event.data.u64 = index;
+        if (epoll_ctl(epoll_fd, EPOLL_CTL_MOD, port.master, &event) == 0) {
+            port.armed_events = wanted;
+        }
+    }
+
+    BasicUARTPty(const BasicUARTPty&) = delete;
+    BasicUARTPty& operator=(const BasicUARTPty&) = delete;
+};
+
+template <typename Driver>
+constexpr size_t BasicUARTPty<Driver>::IO_BLOCK;
+
+template <typename Driver>
+constexpr int BasicUARTPty<Driver>::MAX_EVENTS;
+
+template <typename Driver>
+constexpr uint64_t BasicUARTPty<Driver>::WAKE_TOKEN;
+
+typedef BasicUARTPty<UARTDriver> UARTPty;
+
+} // namespace uart
+
+#endif // __linux__
+
+#endif // UART_PTY_H
@@ -1,6 +1,7 @@
 #ifndef UART_REGISTERS_H
 #define UART_REGISTERS_H
 
+#include <atomic>
 #include <cstdint>
 #include <cstddef>
 
@@ -11,6 +12,12 @@ constexpr uint32_t UART_DATA_REG     = 0x00;  // Data register (TX/RX)
 constexpr uint32_t UART_STATUS_REG   = 0x04;  // Status register
 constexpr uint32_t UART_CONTROL_REG  = 0x08;  // Control register
 constexpr uint32_t UART_BAUD_REG     = 0x0C;  // Baud rate divisor
+constexpr uint32_t UART_FIFO_CTRL_REG = 0x10; // FIFO trigger levels
+constexpr uint32_t UART_INT_ENABLE_REG = 0x14; // Interrupt enable
+constexpr uint32_t UART_INT_STATUS_REG = 0x18; // Interrupt pending (W1C)
+
+// Bytes spanned by the register block
+constexpr size_t REGISTER_BLOCK_SIZE = UART_INT_STATUS_REG + sizeof(uint32_t);
 
 // Status register bits
 constexpr uint32_t STATUS_TX_EMPTY   = (1 << 0);  // TX FIFO empty
@@ -19,6 +26,11 @@ constexpr uint32_t STATUS_RX_EMPTY   = (1 << 2);  // RX FIFO empty
 constexpr uint32_t STATUS_RX_FULL    = (1 << 3);  // RX FIFO full
 constexpr uint32_t STATUS_FRAME_ERR  = (1 << 4);  // Frame error
 constexpr uint32_t STATUS_OVERRUN    = (1 << 5);  // RX overrun error
+constexpr uint32_t STATUS_CTS        = (1 << 6);  // Clear-to-send input asserted
+
+// Status bits that mirror FIFO state, and sticky W1C error bits
+constexpr uint32_t STATUS_FIFO_MASK  = STATUS_TX_EMPTY | STATUS_TX_FULL | STATUS_RX_EMPTY | STATUS_RX_FULL;
+constexpr uint32_t STATUS_ERROR_MASK = STATUS_FRAME_ERR | STATUS_OVERRUN;
 
 // Control register bits
 constexpr uint32_t CTRL_ENABLE       = (1 << 0);  // Enable UART
@@ -26,18 +38,72 @@ constexpr uint32_t CTRL_TX_ENABLE    = (1 << 1);  // Enable transmitter
 constexpr uint32_t CTRL_RX_ENABLE    = (1 << 2);  // Enable receiver
 constexpr uint32_t CTRL_PARITY_EN    = (1 << 3);  // Enable parity
 constexpr uint32_t CTRL_PARITY_ODD   = (1 << 4);  // Odd parity (0=even)
+constexpr uint32_t CTRL_TWO_STOP     = (1 << 5);  // Two stop bits (0=one)
+constexpr uint32_t CTRL_RTSCTS       = (1 << 6);  // Hardware (RTS/CTS) flow control
+constexpr uint32_t CTRL_XONXOFF      = (1 << 7);  // Software (XON/XOFF) flow control
+
+// Flow control modes (see BasicUARTDriver::configureFlowControl)
+constexpr uint32_t CTRL_FLOW_MASK    = CTRL_RTSCTS | CTRL_XONXOFF;
+
+// Software flow control characters
+constexpr uint8_t XON_CHAR           = 0x11;  // DC1: resume transmission
+constexpr uint8_t XOFF_CHAR          = 0x13;  // DC3: pause transmission
 
-// FIFO depth
+// FIFO control register fields (levels scale with FIFO depth; shown for 16)
+constexpr uint32_t FCR_RX_TRIG_MASK     = (3 << 0);
+constexpr uint32_t FCR_RX_TRIG_1        = (0 << 0);  // RX trigger at 1 byte
+constexpr uint32_t FCR_RX_TRIG_QUARTER  = (1 << 0);  // RX trigger at 4 bytes
+constexpr uint32_t FCR_RX_TRIG_HALF     = (2 << 0);  // RX trigger at 8 bytes
+constexpr uint32_t FCR_RX_TRIG_NEAR_FULL = (3 << 0); // RX trigger at 14 bytes
+constexpr uint32_t FCR_TX_LOW_MASK      = (3 << 2);
+constexpr uint32_t FCR_TX_LOW_EMPTY     = (0 << 2);  // TX interrupt when empty
+constexpr uint32_t FCR_TX_LOW_QUARTER   = (1 << 2);  // TX interrupt at 4 bytes
+constexpr uint32_t FCR_TX_LOW_HALF      = (2 << 2);  // TX interrupt at 8 bytes
+constexpr uint32_t FCR_TX_LOW_3QUARTER  = (3 << 2);  // TX interrupt at 12 bytes
+
+// Interrupt enable/status register bits
+constexpr uint32_t INT_RX_TRIGGER    = (1 << 0);  // RX level at or above trigger
+constexpr uint32_t INT_TX_LOW        = (1 << 1);  // TX level fell to low water
+constexpr uint32_t INT_LINE_ERROR    = (1 << 2);  // Overrun or frame error
+
+// DMA request lines
+constexpr uint32_t DMA_REQ_TX        = (1 << 0);  // TX FIFO at or below low water
+constexpr uint32_t DMA_REQ_RX        = (1 << 1);  // RX data ready
+
+// Default FIFO depth (see BasicUARTDriver for other parts)
 constexpr size_t FIFO_DEPTH = 16;
 
+/**
+ * @brief Outcome of simulateReceive(); accepted + dropped == length
+ */
+struct ReceiveResult {
+    size_t accepted;    // Taken by the receiver (queued, or consumed as XON/XOFF)
+    size_t dropped;     // Lost to overrun, or because the receiver is disabled
+};
+
 /**
  * @brief Simulates UART hardware registers
  * 
  * This class models a typical UART peripheral with memory-mapped registers.
  * In real hardware, these would be physical registers at specific addresses.
+ *
+ * The status register is atomic so the application side and the device side
+ * of a driver may update status bits from different threads.
+ *
+ * FIFO status bits can be derived on demand: when a status provider is
+ * installed, reads of the status register combine the stored sticky bits
+ * with the provider's live FIFO bits, so nothing has to keep them up to date
+ * on the data path.
+ *
+ * This is the default register backend of BasicUARTDriver. Another backend
+ * (see MappedUARTRegisters) provides the same member functions and is
+ * selected at compile time through the driver's Registers parameter.
  */
 class UARTRegisters {
 public:
+    // Returns the live STATUS_FIFO_MASK bits for the given context
+    typedef uint32_t (*StatusProvider)(const void* context);
+    
     UARTRegisters();
     
     // Register access
@@ -49,21 +115,40 @@ public:
     void clearStatusBit(uint32_t bit);
     bool isStatusBitSet(uint32_t bit) const;
     
+    // Derive FIFO status bits on demand (nullptr restores stored bits)
+    void setStatusProvider(StatusProvider provider, const void* context);
+    
     // Control register queries
     bool isEnabled() const;
     bool isTxEnabled() const;
     bool isRxEnabled() const;
     bool isParityEnabled() const;
     bool isParityOdd() const;
+    bool isTwoStopBits() const;
+    uint32_t getBaudRate() const;
+    
+    // Interrupt state
+    void setInterruptPending(uint32_t bits);
+    uint32_t getInterruptPending() const;
+    uint32_t getInterruptEnable() const;
+    uint32_t getFifoControl() const;
     
     // Reset to power-on state
     void reset();
     
 private:
     uint32_t data_reg;
-    uint32_t status_reg;
+    std::atomic<uint32_t> status_reg;
     uint32_t control_reg;
     uint32_t baud_reg;
+    uint32_t fifo_ctrl_reg;
+    uint32_t int_enable_reg;
+    std::atomic<uint32_t> int_status_reg;
+    
+    StatusProvider status_provider;
+    const void* status_context;
+    
+    uint32_t readStatus() const;
 };
 
 } // namespace uart
@@ -0,0 +1,393 @@
+#ifndef UART_SHM_H
+#define UART_SHM_H
+
+#include "uart_driver.h"
+#include "uart_mapped_registers.h"
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+#if defined(__linux__)
+
+#include <chrono>
+#include <climits>
+#include <ctime>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <memory>
+#include <new>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace uart {
+
+constexpr uint32_t SHM_MAGIC   = 0x55534D31;  // "USM1"
+constexpr uint32_t SHM_VERSION = 1;
+
+/**
+ * @brief Counters for one process's view of a shared-memory UART
+ */
+struct ShmStats {
+    uint64_t waits;     // futex waits entered
+    uint64_t wakes;     // futex wakes issued
+};
+
+/**
+ * @brief Futex-backed event in shared memory
+ *
+ * A side that runs out of data or space registers in waiters, snapshots
+ * sequence, re-checks its ring and only then sleeps on sequence. The other
+ * side publishes ring progress, issues a full fence and wakes only if
+ * waiters is non-zero, so a transfer nobody is waiting for costs a fence
+ * and a load, never a system call.
+ */
+struct alignas(CACHE_LINE_SIZE) ShmWaitQueue {
+    std::atomic<uint32_t> sequence;
+    std::atomic<uint32_t> waiters;
+};
+
+/**
+ * @brief Layout of a shared-memory UART region
+ */
+template <size_t TxDepth, size_t RxDepth>
+struct ShmUARTLayout {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t tx_depth;
+    uint32_t rx_depth;
+    std::atomic<uint32_t> ready;    // Set last by the creator
+
+    alignas(CACHE_LINE_SIZE) uint32_t registers[REGISTER_BLOCK_SIZE / sizeof(uint32_t)];
+
+    ShmWaitQueue tx_data;   // Device waits for characters to transmit
+    ShmWaitQueue tx_space;  // Application waits for TX space
+    ShmWaitQueue rx_data;   // Application waits for received characters
+    ShmWaitQueue rx_space;  // Device waits for RX space
+
+    SPSCRingPair<TxDepth, RxDepth> fifos;
+};
+
+/**
+ * @brief UART whose FIFOs and registers live in POSIX shared memory
+ *
+ * One process creates the region with create() and another maps it with
+ * attach(). Each then gets a BasicUARTDriver over the region: its FIFOs are
+ * the SPSCRingPair in the region (MappedFifos) and its registers are a
+ * MappedUARTRegisters block there, so data, control, status and errors are
+ * shared and the driver's own data path does the work. The application
+ * process uses the application-side calls and the device-model process the
+ * device-side calls, exactly as the two threads of one driver would.
+ *
+ * The wait*() calls block on a futex when a side has nothing to do. The
+ * data calls below forward to driver() and then wake the peer, which only
+ * enters the kernel when someone is actually waiting; use them rather than
+ * driver()'s for anything a peer may wait on. Configuration, status and
+ * statistics go through driver() directly. Flow control, the software tier
+ * and callbacks are per driver object and are not shared.
+ *
+ * Each process gets its own object; one thread per side at a time. The
+ * region is Linux-only because it relies on shared futexes.
+ */
+template <size_t TxDepth, size_t RxDepth>
+class BasicShmUART {
+public:
+    typedef ShmUARTLayout<TxDepth, RxDepth> Layout;
+    typedef BasicUARTDriver<TxDepth, RxDepth, MappedUARTRegisters, MappedFifos<TxDepth, RxDepth> > Driver;
+
+    static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t) &&
+                  sizeof(std::atomic<size_t>) == sizeof(size_t),
+                  "Shared atomics must have the layout of their value type");
+#if defined(__cpp_lib_atomic_is_always_lock_free)
+    // A lock-based atomic keeps its lock in this process, not in the region
+    static_assert(std::atomic<uint32_t>::is_always_lock_free && std::atomic<size_t>::is_always_lock_free,
+                  "Shared atomics (flags, futex words, ring indices) must be lock-free");
+#endif
+
+    BasicShmUART()
+        : layout(nullptr) {
+        resetStats();
+    }
+
+    ~BasicShmUART() {
+        close();
+    }
+
+    /**
+     * @brief Create and map a new region (name as for shm_open, e.g. "/uart0")
+     * @return false if the name exists, the region cannot be mapped, or the
+     *         shared atomics are not lock-free on this platform
+     */
+    bool create(const char* name) {
+        close();
+        if (!atomicsLockFree()) {
+            return false;
+        }
+        int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+        if (fd < 0) {
+            return false;
+        }
+        if (ftruncate(fd, sizeof(Layout)) != 0 || !map(fd)) {
+            ::close(fd);
+            shm_unlink(name);
+            return false;
+        }
+        ::close(fd);
+
+        new (layout) Layout();
+        layout->magic = SHM_MAGIC;
+        layout->version = SHM_VERSION;
+        layout->tx_depth = static_cast<uint32_t>(TxDepth);
+        layout->rx_depth = static_cast<uint32_t>(RxDepth);
+        MappedUARTRegisters(layout->registers).reset();
+        port.reset(new Driver(layout->registers, &layout->fifos));
+        layout->ready.store(1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Map a region made by create() in another process
+     * @return false if it does not exist, has a different layout, or the
+     *         shared atomics are not lock-free on this platform
+     */
+    bool attach(const char* name) {
+        close();
+        if (!atomicsLockFree()) {
+            return false;
+        }
+        int fd = shm_open(name, O_RDWR | O_CLOEXEC, 0);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat info;
+        bool ok = fstat(fd, &info) == 0 && info.st_size == static_cast<off_t>(sizeof(Layout)) && map(fd);
+        ::close(fd);
+        if (!ok) {
+            return false;
+        }
+        if (layout->ready.load(std::memory_order_acquire) != 1 || layout->magic != SHM_MAGIC ||
+            layout->version != SHM_VERSION || layout->tx_depth != TxDepth || layout->rx_depth != RxDepth) {
+            close();
+            return false;
+        }
+        port.reset(new Driver(layout->registers, &layout->fifos));
+        return true;
+    }
+
+    /**
+     * @brief Unmap the region (it persists until unlink())
+     * The port keeps running for the peer; use shutdown() to stop it.
+     */
+    void close() {
+        port.reset();
+        if (layout) {
+            munmap(layout, sizeof(Layout));
+            layout = nullptr;
+        }
+    }
+
+    /**
+     * @brief Remove a region name; mappings stay valid until closed
+     */
+    static bool unlink(const char* name) {
+        return shm_unlink(name) == 0;
+    }
+
+    bool isOpen() const { return layout != nullptr; }
+
+    /**
+     * @brief This process's driver over the shared port (valid while open)
+     */
+    Driver& driver() { return *port; }
+    const Driver& driver() const { return *port; }
+
+    /**
+     * @brief Disable the port and wake any waiter on either side
+     * Unlike the driver's shutdown() the FIFOs are left alone, since the
+     * peer may still be using them.
+     */
+    void shutdown() {
+        MappedUARTRegisters(layout->registers).writeRegister(UART_CONTROL_REG, 0);
+        wakeAll(layout->tx_data);
+        wakeAll(layout->tx_space);
+        wakeAll(layout->rx_data);
+        wakeAll(layout->rx_space);
+    }
+
+    // Application side
+
+    size_t writeData(const uint8_t* data, size_t length) {
+        size_t queued = port->writeData(data, length);
+        if (queued > 0) {
+            notify(layout->tx_data);
+        }
+        return queued;
+    }
+
+    size_t readData(uint8_t* buffer, size_t max_length) {
+        size_t read = port->readData(buffer, max_length);
+        if (read > 0) {
+            notify(layout->rx_space);
+        }
+        return read;
+    }
+
+    /**
+     * @brief Block until received data is available or the port is disabled
+     * @param timeout_ms Longest wait (-1 = forever)
+     * @return true if data is available
+     */
+    bool waitReadable(int timeout_ms) {
+        return wait(layout->rx_data, &BasicShmUART::rxReady, timeout_ms);
+    }
+
+    /**
+     * @brief Block until the TX FIFO has space or the port is disabled
+     */
+    bool waitWritable(int timeout_ms) {
+        return wait(layout->tx_space, &BasicShmUART::txSpaceReady, timeout_ms);
+    }
+
+    // Device side
+
+    ReceiveResult simulateReceive(const uint8_t* data, size_t length) {
+        ReceiveResult result = port->simulateReceive(data, length);
+        if (result.accepted > 0) {
+            notify(layout->rx_data);
+        }
+        return result;
+    }
+
+    size_t drainTx(uint8_t* out, size_t max_length) {
+        size_t sent = port->drainTx(out, max_length);
+        if (sent > 0) {
+            notify(layout->tx_space);
+        }
+        return sent;
+    }
+
+    size_t simulateTransmit(size_t num_bytes) {
+        size_t sent = port->simulateTransmit(num_bytes);
+        if (sent > 0) {
+            notify(layout->tx_space);
+        }
+        return sent;
+    }
+
+    /**
+     * @brief Block until there are characters to transmit or the port is disabled
+     */
+    bool waitTransmitData(int timeout_ms) {
+        return wait(layout->tx_data, &BasicShmUART::txDataReady, timeout_ms);
+    }
+
+    /**
+     * @brief Block until the RX FIFO has space or the port is disabled
+     */
+    bool waitReceiveSpace(int timeout_ms) {
+        return wait(layout->rx_space, &BasicShmUART::rxSpaceReady, timeout_ms);
+    }
+
+    const ShmStats& getStats() const { return stats; }
+
+    void resetStats() {
+        stats.waits = 0;
+        stats.wakes = 0;
+    }
+
+private:
+    Layout* layout;
+    std::unique_ptr<Driver> port;
+    ShmStats stats;
+
+    bool map(int fd) {
+        void* region = mmap(nullptr, sizeof(Layout), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (region == MAP_FAILED) {
+            return false;
+        }
+        layout = static_cast<Layout*>(region);
+        return true;
+    }
+
+    // Runtime form of the static_assert above, for pre-C++17 builds
+    static bool atomicsLockFree() {
+        std::atomic<uint32_t> word(0);
+        std::atomic<size_t> index(0);
+        return word.is_lock_free() && index.is_lock_free();
+    }
+
+    bool isEnabled() const { return (port->readControl() & CTRL_ENABLE) != 0; }
+
+    // Wake conditions; a disabled port also ends every wait
+    bool rxReady() const { return port->getRxFifoCount() > 0; }
+    bool txSpaceReady() const { return port->getTxFifoCount() < TxDepth; }
+    bool txDataReady() const { return port->getTxFifoCount() > 0; }
+    bool rxSpaceReady() const { return port->getRxFifoCount() < RxDepth; }
+
+    bool wait(ShmWaitQueue& queue, bool (BasicShmUART::*ready)() const, int timeout_ms) {
+        typedef std::chrono::steady_clock Clock;
+        Clock::time_point deadline = Clock::now() + std::chrono::milliseconds(timeout_ms < 0 ? 0 : timeout_ms);
+        for (;;) {
+            if ((this->*ready)()) {
+                return true;
+            }
+            if (!isEnabled()) {
+                return false;
+            }
+
+            struct timespec remaining;
+            struct timespec* timeout = nullptr;
+            if (timeout_ms >= 0) {
+                Clock::duration left = deadline - Clock::now();
+                if (left <= Clock::duration::zero()) {
+                    return false;
+                }
+                long long ns = std::chrono::duration_cast<std::chrono::nanoseconds>(left).count();
+                remaining.tv_sec = static_cast<time_t>(ns / 1000000000LL);
+                remaining.tv_nsec = static_cast<long>(ns % 1000000000LL);
+                timeout = &remaining;
+            }
+
+            // Register, snapshot, re-check: a notify after the snapshot
+            // changes sequence and the futex wait returns immediately
+            queue.waiters.fetch_add(1, std::memory_order_seq_cst);
+            uint32_t seq = queue.sequence.load(std::memory_order_seq_cst);
+            if (!(this->*ready)() && isEnabled()) {
+                stats.waits++;
+                futex(&queue.sequence, FUTEX_WAIT, seq, timeout);
+            }
+            queue.waiters.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    void notify(ShmWaitQueue& queue) {
+        // Order the ring update before the waiter check (pairs with wait())
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (queue.waiters.load(std::memory_order_relaxed) != 0) {
+            wakeAll(queue);
+        }
+    }
+
+    void wakeAll(ShmWaitQueue& queue) {
+        queue.sequence.fetch_add(1, std::memory_order_seq_cst);
+        futex(&queue.sequence, FUTEX_WAKE, INT_MAX, nullptr);
+        stats.wakes++;
+    }
+
+    static long futex(std::atomic<uint32_t>* word, int op, uint32_t value, const struct timespec* timeout) {
+        // Shared (not FUTEX_PRIVATE) so waiters in other processes are found
+        return syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), op, value, timeout, nullptr, 0);
+    }
+
+    BasicShmUART(const BasicShmUART&) = delete;
+    BasicShmUART& operator=(const BasicShmUART&) = delete;
+};
+
+typedef BasicShmUART<FIFO_DEPTH, FIFO_DEPTH> ShmUART;
+
+} // namespace uart
+
+#endif // __linux__
+
+#endif // UART_SHM_H
@@ -0,0 +1,474 @@
+#ifndef UART_SPSC_RING_H
+#define UART_SPSC_RING_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+
+#if defined(_MSC_VER)
+#include <malloc.h>
+#else
+#include <stdlib.h>
+#endif
+
+namespace uart {
+
+// Assumed cache line size used to keep producer and consumer state apart
+constexpr size_t CACHE_LINE_SIZE = 64;
+
+/**
+ * @brief Base for types aligned to CACHE_LINE_SIZE
+ *
+ * Before C++17, new only guarantees alignof(std::max_align_t), so new and
+ * new[] of a cache-line aligned type would return under-aligned memory.
+ * Deriving from this gives the type class-specific allocation functions that
+ * honour the alignment. Containers that use std::allocator do not go through
+ * them; allocate such types with new[] instead.
+ */
+struct CacheLineAligned {
+    static void* operator new(size_t size) { return allocate(size); }
+    static void* operator new[](size_t size) { return allocate(size); }
+    static void operator delete(void* pointer) { release(pointer); }
+    static void operator delete[](void* pointer) { release(pointer); }
+
+private:
+    static void* allocate(size_t size) {
+        void* pointer = nullptr;
+#if defined(_MSC_VER)
+        pointer = _aligned_malloc(size ? size : 1, CACHE_LINE_SIZE);
+#else
+        if (posix_memalign(&pointer, CACHE_LINE_SIZE, size ? size : 1) != 0) {
+            pointer = nullptr;
+        }
+#endif
+        if (!pointer) {
+            throw std::bad_alloc();
+        }
+        return pointer;
+    }
+
+    static void release(void* pointer) {
+#if defined(_MSC_VER)
+        _aligned_free(pointer);
+#else
+        free(pointer);
+#endif
+    }
+};
+
+constexpr bool isPowerOfTwo(size_t value) {
+    return value != 0 && (value & (value - 1)) == 0;
+}
+
+/**
+ * @brief Contiguous read-only byte region
+ */
+struct ConstByteSpan {
+    const uint8_t* data;
+    size_t size;
+};
+
+/**
+ * @brief Contiguous writable byte region
+ */
+struct ByteSpan {
+    uint8_t* data;
+    size_t size;
+};
+
+/**
+ * @brief Readable ring contents: first region, then the wrapped remainder
+ */
+struct ConstByteRegions {
+    ConstByteSpan first;
+    ConstByteSpan second;
+
+    size_t size() const { return first.size + second.size; }
+};
+
+/**
+ * @brief Writable ring space: first region, then the wrapped remainder
+ */
+struct ByteRegions {
+    ByteSpan first;
+    ByteSpan second;
+
+    size_t size() const { return first.size + second.size; }
+};
+
+/**
+ * @brief Ring storage sized at compile time (hardware FIFOs)
+ */
+template <size_t Depth>
+class FixedRingStorage {
+    static_assert(isPowerOfTwo(Depth), "SPSCRing depth must be a power of two");
+
+public:
+    FixedRingStorage() {
+        memset(bytes, 0, sizeof(bytes));
+    }
+
+    static constexpr size_t capacity() { return Depth; }
+    uint8_t* data() { return bytes; }
+    const uint8_t* data() const { return bytes; }
+
+private:
+    uint8_t bytes[Depth];
+};
+
+/**
+ * @brief Ring storage sized at run time, on the heap or in caller memory
+ *
+ * Capacity is zero until allocate() or attach() is called.
+ */
+class DynamicRingStorage {
+public:
+    DynamicRingStorage()
+        : bytes(nullptr)
+        , size(0) {
+    }
+
+    size_t capacity() const { return size; }
+    uint8_t* data() { return bytes; }
+    const uint8_t* data() const { return bytes; }
+
+    /**
+     * @brief Allocate heap storage, rounding capacity up to a power of two
+     */
+    void allocate(size_t min_capacity) {
+        size_t cap = 1;
+        while (cap < min_capacity) {
+            cap <<= 1;
+        }
+        owned.reset(new uint8_t[cap]);
+        bytes = owned.get();
+        size = cap;
+    }
+
+    /**
+     * @brief Use caller-owned memory (e.g. an arena slice)
+     * @return false if capacity is not a power of two
+     */
+    bool attach(uint8_t* memory, size_t capacity) {
+        if (!memory || !isPowerOfTwo(capacity)) {
+            return false;
+        }
+        owned.reset();
+        bytes = memory;
+        size = capacity;
+        return true;
+    }
+
+    void release() {
+        owned.reset();
+        bytes = nullptr;
+        size = 0;
+    }
+
+private:
+    std::unique_ptr<uint8_t[]> owned;
+    uint8_t* bytes;
+    size_t size;
+};
+
+/**
+ * @brief Wait-free single-producer/single-consumer byte ring
+ *
+ * Models one FIFO. The producer advances head, the consumer advances tail;
+ * both are free-running counters published with release stores and observed
+ * with acquire loads, so there is no shared count to contend on. Producer
+ * state, consumer state and the storage each start on their own aligned
+ * cache line. Capacity is a power of two so index wrap is a mask rather than
+ * a division.
+ *
+ * Exactly one thread may call the producer functions and exactly one thread
+ * may call the consumer functions at a time. reset() and any change of
+ * storage require both sides to be quiescent.
+ */
+template <typename Storage>
+class BasicSPSCRing : public CacheLineAligned {
+public:
+    BasicSPSCRing()
+        : head(0)
+        , cached_tail(0)
+        , tail(0)
+        , cached_head(0) {
+    }
+
+    size_t capacity() const { return storage.capacity(); }
+
+    // Producer side
+
+    /**
+     * @brief Number of bytes the producer can write without overflowing
+     */
+    size_t freeSpace() {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (capacity() - (h - cached_tail) == 0) {
+            cached_tail = tail.load(std::memory_order_acquire);
+        }
+        return capacity() - (h - cached_tail);
+    }
+
+    /**
+     * @brief Append one byte
+     * @return false if the ring is full
+     */
+    bool push(uint8_t data) {
+        if (freeSpace() == 0) {
+            return false;
+        }
+        size_t h = head.load(std::memory_order_relaxed);
+        storage.data()[h & mask()] = data;
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Append up to length bytes in at most two segments
+     * @return Number of bytes written
+     */
+    size_t write(const uint8_t* data, size_t length) {
+        size_t h = head.load(std::memory_order_relaxed);
+        size_t space = capacity() - (h - cached_tail);
+        if (space < length) {
+            cached_tail = tail.load(std::memory_order_acquire);
+            space = capacity() - (h - cached_tail);
+        }
+        size_t to_write = (length < space) ? length : space;
+        if (to_write == 0) {
+            return 0;
+        }
+
+        size_t index = h & mask();
+        size_t first = capacity() - index;
+        if (first > to_write) {
+            first = to_write;
+        }
+        memcpy(storage.data() + index, data, first);
+        memcpy(storage.data(), data + first, to_write - first);
+
+        head.store(h + to_write, std::memory_order_release);
+        return to_write;
+    }
+
+    /**
+     * @brief Expose up to length bytes of free space for in-place writes
+     * The space is published by commit(); nothing is visible before that.
+     */
+    ByteRegions reserve(size_t length) {
+        size_t h = head.load(std::memory_order_relaxed);
+        size_t space = capacity() - (h - cached_tail);
+        if (space < length) {
+            cached_tail = tail.load(std::memory_order_acquire);
+            space = capacity() - (h - cached_tail);
+        }
+        size_t size = (length < space) ? length : space;
+
+        size_t index = h & mask();
+        size_t first = capacity() - index;
+        if (first > size) {
+            first = size;
+        }
+        ByteRegions regions;
+        regions.first.data = storage.data() + index;
+        regions.first.size = first;
+        regions.second.data = storage.data();
+        regions.second.size = size - first;
+        return regions;
+    }
+
+    /**
+     * @brief Publish num_bytes previously written into reserve()d space
+     * Clamped to the free space, so an over-commit cannot pass the consumer.
+     * @return Number of bytes published
+     */
+    size_t commit(size_t num_bytes) {
+        size_t h = head.load(std::memory_order_relaxed);
+        size_t space = capacity() - (h - cached_tail);
+        if (space < num_bytes) {
+            cached_tail = tail.load(std::memory_order_acquire);
+            space = capacity() - (h - cached_tail);
+            num_bytes = (num_bytes < space) ? num_bytes : space;
+        }
+        head.store(h + num_bytes, std::memory_order_release);
+        return num_bytes;
+    }
+
+    // Consumer side
+
+    /**
+     * @brief Number of bytes the consumer can read
+     */
+    size_t available() {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (cached_head == t) {
+            cached_head = head.load(std::memory_order_acquire);
+        }
+        return cached_head - t;
+    }
+
+    /**
+     * @brief Remove one byte
+     * @return false if the ring is empty
+     */
+    bool pop(uint8_t& data) {
+        if (available() == 0) {
+            return false;
+        }
+        size_t t = tail.load(std::memory_order_relaxed);
+        data = storage.data()[t & mask()];
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Remove up to max_length bytes in at most two segments
+     * @return Number of bytes read
+     */
+    size_t read(uint8_t* buffer, size_t max_length) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        size_t used = cached_head - t;
+        if (used < max_length) {
+            cached_head = head.load(std::memory_order_acquire);
+            used = cached_head - t;
+        }
+        size_t to_read = (max_length < used) ? max_length : used;
+        if (to_read == 0) {
+            return 0;
+        }
+
+        size_t index = t & mask();
+        size_t first = capacity() - index;
+        if (first > to_read) {
+            first = to_read;
+        }
+        memcpy(buffer, storage.data() + index, first);
+        memcpy(buffer + first, storage.data(), to_read - first);
+
+        tail.store(t + to_read, std::memory_order_release);
+        return to_read;
+    }
+
+    /**
+     * @brief Expose readable bytes in place, without copying
+     * The regions stay valid until consumed with discard().
+     */
+    ConstByteRegions peek() {
+        size_t t = tail.load(std::memory_order_relaxed);
+        cached_head = head.load(std::memory_order_acquire);
+        size_t used = cached_head - t;
+
+        size_t index = t & mask();
+        size_t first = capacity() - index;
+        if (first > used) {
+            first = used;
+        }
+        ConstByteRegions regions;
+        regions.first.data = storage.data() + index;
+        regions.first.size = first;
+        regions.second.data = storage.data();
+        regions.second.size = used - first;
+        return regions;
+    }
+
+    /**
+     * @brief Drop up to num_bytes from the front of the ring
+     * @return Number of bytes dropped
+     */
+    size_t discard(size_t num_bytes) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        size_t used = head.load(std::memory_order_acquire) - t;
+        size_t to_drop = (num_bytes < used) ? num_bytes : used;
+        tail.store(t + to_drop, std::memory_order_release);
+        return to_drop;
+    }
+
+    /**
+     * @brief Move up to max_length bytes from this ring into another
+     *
+     * Consumer side of this ring, producer side of the destination.
+     * @return Number of bytes moved
+     */
+    template <typename OtherStorage>
+    size_t transferTo(BasicSPSCRing<OtherStorage>& dest, size_t max_length) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        size_t used = head.load(std::memory_order_acquire) - t;
+        size_t to_move = (max_length < used) ? max_length : used;
+
+        // At most two source segments, each copied with a bulk write
+        size_t index = t & mask();
+        size_t first = capacity() - index;
+        if (first > to_move) {
+            first = to_move;
+        }
+        size_t moved = dest.write(storage.data() + index, first);
+        if (moved == first && to_move > first) {
+            moved += dest.write(storage.data(), to_move - first);
+        }
+
+        tail.store(t + moved, std::memory_order_release);
+        return moved;
+    }
+
+    // Either side
+
+    /**
+     * @brief Snapshot of the fill level; exact when the other side is idle
+     */
+    size_t count() const {
+        size_t t = tail.load(std::memory_order_acquire);
+        size_t h = head.load(std::memory_order_acquire);
+        return h - t;
+    }
+
+    bool empty() const { return count() == 0; }
+    bool full() const { return count() >= capacity(); }
+
+    /**
+     * @brief Empty the ring; both sides must be idle
+     */
+    void reset() {
+        head.store(0, std::memory_order_relaxed);
+        tail.store(0, std::memory_order_relaxed);
+        cached_tail = 0;
+        cached_head = 0;
+    }
+
+    /**
+     * @brief Backing storage; resizing it requires both sides to be idle
+     */
+    Storage& getStorage() { return storage; }
+
+private:
+    size_t mask() const { return capacity() - 1; }
+
+    // Producer-owned cache line; the alignment also keeps it clear of
+    // whatever precedes the ring
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> head;
+    size_t cached_tail;
+
+    // Consumer-owned cache line
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail;
+    size_t cached_head;
+
+    // Storage starts on a line of its own
+    alignas(CACHE_LINE_SIZE) Storage storage;
+
+    BasicSPSCRing(const BasicSPSCRing&) = delete;
+    BasicSPSCRing& operator=(const BasicSPSCRing&) = delete;
+};
+
+// Hardware FIFO with compile-time depth
+template <size_t Depth>
+using SPSCRing = BasicSPSCRing<FixedRingStorage<Depth> >;
+
+// Software buffer with run-time capacity
+typedef BasicSPSCRing<DynamicRingStorage> SPSCBuffer;
+
+} // namespace uart
+
+#endif // UART_SPSC_RING_H
@@ -0,0 +1,144 @@
+#ifndef UART_STATS_H
+#define UART_STATS_H
+
+#include "uart_spsc_ring.h"
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+namespace uart {
+
+// Occupancy histogram resolution: bucket i counts samples at i/8 to (i+1)/8 full
+constexpr size_t OCCUPANCY_BUCKETS = 8;
+
+/**
+ * @brief Snapshot of a port's counters (see BasicUARTDriver::getStats)
+ */
+struct PortStats {
+    uint64_t tx_bytes;          // Characters transmitted on the line
+    uint64_t rx_bytes;          // Characters accepted from the line
+    uint64_t overrun_events;    // Receive bursts that did not fit
+    uint64_t rx_dropped_bytes;  // Characters lost to overruns
+    uint64_t frame_errors;      // Characters that failed the parity check
+    uint64_t tx_full_rejects;   // Writes that could not queue every byte
+    uint64_t rx_high_water;     // Highest RX level seen, in bytes
+    uint64_t tx_high_water;     // Highest TX level seen, in bytes
+    uint64_t rx_occupancy[OCCUPANCY_BUCKETS];  // RX level after each receive burst
+};
+
+/**
+ * @brief Counter written by exactly one thread and read by any
+ *
+ * The owner updates with a relaxed load and store rather than a locked
+ * read-modify-write, so counting costs the same as a plain increment.
+ */
+class RelaxedCounter {
+public:
+    RelaxedCounter() : value(0) {}
+
+    void add(uint64_t n) {
+        value.store(value.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+    void raiseTo(uint64_t candidate) {
+        if (candidate > value.load(std::memory_order_relaxed)) {
+            value.store(candidate, std::memory_order_relaxed);
+        }
+    }
+
+    uint64_t get() const { return value.load(std::memory_order_relaxed); }
+    void reset() { value.store(0, std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint64_t> value;
+};
+
+/**
+ * @brief Live per-port counters
+ *
+ * Each counter has a single writer: the device side owns the line, error and
+ * RX counters, and the application side owns the TX queueing counters, which
+ * keeps them on separate cache lines. snapshot() may run on any thread and
+ * sees each counter at some recent value; counters are not captured as one
+ * atomic unit.
+ */
+class PortCounters {
+public:
+    // Device side
+    void recordTransmit(size_t bytes) { tx_bytes.add(bytes); }
+
+    void recordReceive(size_t accepted, size_t dropped, size_t level, size_t capacity) {
+        rx_bytes.add(accepted);
+        if (dropped) {
+            overrun_events.add(1);
+            rx_dropped_bytes.add(dropped);
+        }
+        rx_high_water.raiseTo(level);
+        size_t bucket = capacity ? level * OCCUPANCY_BUCKETS / capacity : 0;
+        if (bucket >= OCCUPANCY_BUCKETS) {
+            bucket = OCCUPANCY_BUCKETS - 1;
+        }
+        rx_occupancy[bucket].add(1);
+    }
+
+    void recordFrameErrors(size_t count) { frame_errors.add(count); }
+
+    // Application side
+    void recordWrite(size_t requested, size_t queued, size_t level) {
+        if (queued < requested) {
+            tx_full_rejects.add(1);
+        }
+        tx_high_water.raiseTo(level);
+    }
+
+    PortStats snapshot() const {
+        PortStats stats;
+        stats.tx_bytes = tx_bytes.get();
+        stats.rx_bytes = rx_bytes.get();
+        stats.overrun_events = overrun_events.get();
+        stats.rx_dropped_bytes = rx_dropped_bytes.get();
+        stats.frame_errors = frame_errors.get();
+        stats.tx_full_rejects = tx_full_rejects.get();
+        stats.rx_high_water = rx_high_water.get();
+        stats.tx_high_water = tx_high_water.get();
+        for (size_t i = 0; i < OCCUPANCY_BUCKETS; i++) {
+            stats.rx_occupancy[i] = rx_occupancy[i].get();
+        }
+        return stats;
+    }
+
+    /**
+     * @brief Zero every counter; both sides must be idle
+     */
+    void reset() {
+        tx_bytes.reset();
+        rx_bytes.reset();
+        overrun_events.reset();
+        rx_dropped_bytes.reset();
+        frame_errors.reset();
+        tx_full_rejects.reset();
+        rx_high_water.reset();
+        tx_high_water.reset();
+        for (size_t i = 0; i < OCCUPANCY_BUCKETS; i++) {
+            rx_occupancy[i].reset();
+        }
+    }
+
+private:
+    // Device-owned
+    RelaxedCounter tx_bytes;
+    RelaxedCounter rx_bytes;
+    RelaxedCounter overrun_events;
+    RelaxedCounter rx_dropped_bytes;
+    RelaxedCounter frame_errors;
+    RelaxedCounter rx_high_water;
+    RelaxedCounter rx_occupancy[OCCUPANCY_BUCKETS];
+
+    // Application-owned
+    alignas(CACHE_LINE_SIZE) RelaxedCounter tx_full_rejects;
+    RelaxedCounter tx_high_water;
+};
+
+} // namespace uart
+
+#endif // UART_STATS_H
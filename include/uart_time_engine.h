@@ -0,0 +1,315 @@
+#ifndef UART_TIME_ENGINE_H
+#define UART_TIME_ENGINE_H
+
+#include "uart_driver.h"
+#include <cstdint>
+#include <cstddef>
+#include <deque>
+#include <vector>
+
+namespace uart {
+
+/**
+ * @brief Link statistics collected by the virtual time engine
+ */
+struct LinkTimingStats {
+    uint64_t elapsed_ns;         // Virtual time covered by the engine
+    uint64_t tx_busy_ns;         // Time the transmitter spent shifting characters
+    uint64_t tx_bytes;           // Characters completed on the TX line
+    uint64_t rx_bytes;           // Characters the receiver accepted
+    uint64_t rx_dropped_bytes;   // Characters that arrived but were lost to overrun
+    double tx_occupancy_ns;      // Integral of queued TX bytes over time
+
+    // Fraction of elapsed time the TX line was busy
+    double txUtilization() const {
+        return elapsed_ns ? static_cast<double>(tx_busy_ns) / elapsed_ns : 0.0;
+    }
+
+    // Mean time a byte spends queued plus on the wire (Little's law)
+    double meanTxDelayNs() const {
+        return tx_bytes ? tx_occupancy_ns / tx_bytes : 0.0;
+    }
+};
+
+/**
+ * @brief Baud-accurate virtual clock that drives a UART's device side
+ *
+ * Time advances in simulated nanoseconds. The transmitter completes one
+ * character every getCharacterTimeNs() while TX data is queued; scheduled RX
+ * bytes arrive back to back at the same line rate. Events are processed in
+ * time order and in batches, but a batch never crosses the RX trigger or TX
+ * low-water level, so interrupt handlers observe the same timing as they
+ * would with per-character stepping.
+ *
+ * Flow control is honoured: while the transmitter is paused (CTS low or
+ * XOFF received) the TX event is parked, and it is re-armed at the first step
+ * after CTS returns or XON arrives. XON/XOFF characters the driver injects
+ * take a character time and are counted like data.
+ *
+ * runUntil() advances to a fixed time; runToIdle() runs as fast as possible
+ * until the line is quiet. Both are deterministic. Character time is rounded
+ * to whole nanoseconds.
+ */
+template <typename Driver>
+class BasicUARTTimeEngine {
+public:
+    static constexpr uint64_t NEVER = ~0ULL;
+
+    explicit BasicUARTTimeEngine(Driver& driver)
+        : uart(driver)
+        , now_ns(0)
+        , tx_done_ns(NEVER) {
+        resetStats();
+    }
+
+    /**
+     * @brief Current virtual time in nanoseconds
+     */
+    uint64_t now() const { return now_ns; }
+
+    /**
+     * @brief Queue bytes to arrive on the RX line
+     * @param at_ns Start of the first character; arrival is serialized after
+     *              any bytes already scheduled
+     */
+    void scheduleReceive(const uint8_t* data, size_t length, uint64_t at_ns) {
+        if (!data || length == 0) {
+            return;
+        }
+        RxSegment segment;
+        segment.start_ns = (at_ns > now_ns) ? at_ns : now_ns;
+        if (!rx_pending.empty()) {
+            uint64_t busy_until = rxSegmentEnd(rx_pending.back());
+            if (segment.start_ns < busy_until) {
+                segment.start_ns = busy_until;
+            }
+        }
+        segment.bytes.assign(data, data + length);
+        segment.offset = 0;
+        rx_pending.push_back(segment);
+    }
+
+    /**
+     * @brief Queue bytes to arrive starting now
+     */
+    void scheduleReceive(const uint8_t* data, size_t length) {
+        scheduleReceive(data, length, now_ns);
+    }
+
+    /**
+     * @brief Advance virtual time to end_ns, processing all line events
+     */
+    void runUntil(uint64_t end_ns) {
+        while (step(end_ns)) {
+        }
+        if (end_ns != NEVER && end_ns > now_ns) {
+            advanceTo(end_ns);
+        }
+    }
+
+    /**
+     * @brief Run as fast as possible until nothing can be sent and no RX is scheduled
+     * @return Virtual time at which the line went idle
+     * Returns with TX data still queued if the transmitter is paused.
+     */
+    uint64_t runToIdle() {
+        runUntil(NEVER);
+        return now_ns;
+    }
+
+    /**
+     * @brief True if nothing is queued for transmission or scheduled to arrive
+     */
+    bool idle() const {
+        return txLevel() == 0 && rx_pending.empty();
+    }
+
+    const LinkTimingStats& getStats() const { return stats; }
+
+    void resetStats() {
+        stats.elapsed_ns = 0;
+        stats.tx_busy_ns = 0;
+        stats.tx_bytes = 0;
+        stats.rx_bytes = 0;
+        stats.rx_dropped_bytes = 0;
+        stats.tx_occupancy_ns = 0.0;
+    }
+
+private:
+    struct RxSegment {
+        uint64_t start_ns;
+        std::vector<uint8_t> bytes;
+        size_t offset;
+    };
+
+    Driver& uart;
+    uint64_t now_ns;
+    uint64_t tx_done_ns;  // Completion time of the character on the TX line
+    std::deque<RxSegment> rx_pending;
+    LinkTimingStats stats;
+
+    uint64_t characterTime() const {
+        uint64_t ct = uart.getCharacterTimeNs();
+        return ct ? ct : 1;
+    }
+
+    size_t txLevel() const {
+        return uart.getTxFifoCount() + uart.getTxBufferCount();
+    }
+
+    // Something can go out on the TX line now
+    bool txReady() const {
+        return (txLevel() > 0 && !uart.isTxPaused()) || uart.isFlowCharPending();
+    }
+
+    size_t rxLevel() const {
+        return uart.getRxFifoCount() + uart.getRxBufferCount();
+    }
+
+    uint64_t rxSegmentEnd(const RxSegment& segment) const {
+        return segment.start_ns + segment.bytes.size() * characterTime();
+    }
+
+    // Completion time of the next scheduled RX character
+    uint64_t nextRxTime() const {
+        if (rx_pending.empty()) {
+            return NEVER;
+        }
+        const RxSegment& segment = rx_pending.front();
+        return segment.start_ns + (segment.offset + 1) * characterTime();
+    }
+
+    void advanceTo(uint64_t t) {
+        stats.tx_occupancy_ns += static_cast<double>(txLevel()) * (t - now_ns);
+        stats.elapsed_ns += t - now_ns;
+        now_ns = t;
+    }
+
+    // Process one batch of events no later than end_ns; false when done
+    bool step(uint64_t end_ns) {
+        uint64_t ct = characterTime();
+
+        // Data written while the line was idle, or released by CTS or XON,
+        // starts shifting now; a paused or empty transmitter is parked
+        bool ready = txReady();
+        if (tx_done_ns == NEVER && ready) {
+            tx_done_ns = now_ns + ct;
+        } else if (!ready) {
+            tx_done_ns = NEVER;
+        }
+
+        uint64_t rx_time = nextRxTime();
+        uint64_t next = (tx_done_ns < rx_time) ? tx_done_ns : rx_time;
+        if (next == NEVER || next > end_ns) {
+            return false;
+        }
+
+        if (tx_done_ns <= rx_time) {
+            stepTransmit(ct, rx_time, end_ns);
+        } else {
+            stepReceive(ct, tx_done_ns, end_ns);
+        }
+        return true;
+    }
+
+    void stepTransmit(uint64_t ct, uint64_t limit_ns, uint64_t end_ns) {
+        size_t level = txLevel();
+
+        // A pending XON/XOFF goes first and does not drain the queue
+        uint64_t control = uart.isFlowCharPending() ? 1 : 0;
+        uint64_t sendable = control + (uart.isTxPaused() ? 0 : level);
+
+        // Characters that complete before the next RX event and end_ns
+        uint64_t last = (limit_ns < end_ns) ? limit_ns : end_ns;
+        uint64_t count = 1;
+        if (last != NEVER) {
+            count = (last - tx_done_ns) / ct + 1;
+        } else {
+            count = sendable;
+        }
+        if (count > sendable) {
+            count = sendable;
+        }
+
+        // Stop at the TX low-water crossing so the interrupt fires on time
+        size_t low_water = uart.getTxLowWaterLevel();
+        if (level > low_water && count > control + (level - low_water)) {
+            count = control + (level - low_water);
+        }
+
+        uint64_t finish = tx_done_ns + (count - 1) * ct;
+
+        // Occupancy: level until the first completion, then one less per data character
+        stats.tx_occupancy_ns += static_cast<double>(level) * (tx_done_ns - now_ns);
+        stats.tx_occupancy_ns += static_cast<double>(ct) *
+            ((count - 1) * static_cast<double>(level) -
+             (static_cast<double>(count) * (count - 1) / 2.0 - static_cast<double>(control) * (count - 1)));
+        stats.elapsed_ns += finish - now_ns;
+        now_ns = finish;
+
+        // Count what the driver actually put on the line
+        size_t sent = uart.simulateTransmit(static_cast<size_t>(count));
+        stats.tx_bytes += sent;
+        stats.tx_busy_ns += sent * ct;
+
+        tx_done_ns = txReady() ? finish + ct : NEVER;
+    }
+
+    void stepReceive(uint64_t ct, uint64_t limit_ns, uint64_t end_ns) {
+        RxSegment& segment = rx_pending.front();
+        size_t remaining = segment.bytes.size() - segment.offset;
+        uint64_t first = segment.start_ns + (segment.offset + 1) * ct;
+
+        // Characters that arrive before the next TX completion and end_ns
+        uint64_t last = (limit_ns < end_ns) ? limit_ns : end_ns;
+        uint64_t count = remaining;
+        if (last != NEVER) {
+            if (last == limit_ns) {
+                // Strictly before the TX completion, which wins ties
+                count = (last - first + ct - 1) / ct;
+            } else {
+                count = (last - first) / ct + 1;
+            }
+        }
+        if (count > remaining) {
+            count = remaining;
+        }
+
+        // Stop at the RX trigger crossing so the interrupt fires on time
+        size_t level = rxLevel();
+        size_t trigger = uart.getRxTriggerLevel();
+        if (level < trigger && count > trigger - level) {
+            count = trigger - level;
+        }
+
+        // Stop after an XON/XOFF so the transmitter pauses or resumes on time
+        if (uart.readControl() & CTRL_XONXOFF) {
+            const uint8_t* bytes = &segment.bytes[segment.offset];
+            for (uint64_t i = 0; i < count; i++) {
+                if ((bytes[i] & ~0x02) == XON_CHAR) {
+                    count = i + 1;
+                    break;
+                }
+            }
+        }
+
+        advanceTo(first + (count - 1) * ct);
+        ReceiveResult received = uart.simulateReceive(&segment.bytes[segment.offset], static_cast<size_t>(count));
+        stats.rx_bytes += received.accepted;
+        stats.rx_dropped_bytes += received.dropped;
+
+        segment.offset += static_cast<size_t>(count);
+        if (segment.offset == segment.bytes.size()) {
+            rx_pending.pop_front();
+        }
+    }
+};
+
+template <typename Driver>
+constexpr uint64_t BasicUARTTimeEngine<Driver>::NEVER;
+
+typedef BasicUARTTimeEngine<UARTDriver> UARTTimeEngine;
+
+} // namespace uart
+
+#endif // UART_TIME_ENGINE_H
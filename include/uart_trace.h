@@ -0,0 +1,219 @@
+#ifndef UART_TRACE_H
+#define UART_TRACE_H
+
+#include "uart_driver.h"
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace uart {
+
+/**
+ * Trace file layout (host byte order, little-endian on supported targets):
+ *
+ *   TraceFileHeader
+ *   { TraceRecordHeader, payload, zero padding to 8 bytes } ...
+ *
+ * Every record starts 8-byte aligned, so a mapped trace is read in place
+ * without copying or parsing beyond the fixed-size record header.
+ */
+constexpr uint32_t TRACE_FORMAT_VERSION = 1;
+
+// Largest event one record holds; bigger ones are split (multiple of 8)
+constexpr uint32_t TRACE_MAX_RECORD_LENGTH = 0xFFFFFFF8u;
+
+struct TraceFileHeader {
+    char magic[8];          // "UARTTRC\0"
+    uint32_t version;       // TRACE_FORMAT_VERSION
+    uint32_t header_size;   // sizeof(TraceFileHeader)
+};
+
+struct TraceRecordHeader {
+    uint64_t timestamp_ns;  // Time since the recording started
+    uint32_t length;        // Byte count of the event (payload size for RX/TX write)
+    uint8_t event;          // TRACE_* event type
+    uint8_t reserved[3];
+};
+
+/**
+ * @brief One event read back from a trace; data points into the mapping
+ */
+struct TraceEvent {
+    uint64_t timestamp_ns;
+    uint32_t event;
+    size_t length;
+    const uint8_t* data;    // nullptr for TRACE_TX_DONE
+};
+
+/**
+ * @brief Append-only binary recorder for a driver's traffic
+ *
+ * attach() installs the recorder as the driver's trace hook. Events from the
+ * application and device sides are serialized under a lock into a large
+ * write buffer, which is flushed to the file when full and on close().
+ * Events longer than TRACE_MAX_RECORD_LENGTH are split across records.
+ */
+class TraceRecorder {
+public:
+    TraceRecorder();
+    ~TraceRecorder();
+
+    /**
+     * @brief Create (truncate) a trace file and start the clock
+     */
+    bool open(const char* path);
+
+    /**
+     * @brief Flush buffered records and close the file
+     * @return false if any write failed
+     */
+    bool close();
+
+    bool isOpen() const;
+
+    template <typename Driver>
+    void attach(Driver& uart) {
+        uart.setTraceHook(&TraceRecorder::onEvent, this);
+    }
+
+    template <typename Driver>
+    void detach(Driver& uart) {
+        uart.setTraceHook(nullptr, nullptr);
+    }
+
+    /**
+     * @brief Append one event (normally called through the trace hook)
+     */
+    void record(uint32_t event, const uint8_t* data, size_t length);
+
+    uint64_t getRecordCount() const;
+
+    static void onEvent(uint32_t event, const uint8_t* data, size_t length, void* context);
+
+private:
+    static constexpr size_t BUFFER_SIZE = 1 << 20;
+
+    mutable std::mutex lock;
+    std::FILE* file;
+    std::unique_ptr<uint8_t[]> buffer;
+    size_t used;
+    bool failed;
+    uint64_t records;
+    std::chrono::steady_clock::time_point start;
+
+    void flushLocked();
+    void appendLocked(const void* data, size_t length);
+
+    TraceRecorder(const TraceRecorder&) = delete;
+    TraceRecorder& operator=(const TraceRecorder&) = delete;
+};
+
+/**
+ * @brief Memory-mapped sequential reader for trace files
+ *
+ * The whole file is mapped read-only with sequential read-ahead advice, and
+ * next() returns events that point straight into the mapping. A record cut
+ * off at the end of the file (a recording that did not close cleanly) ends
+ * the trace and is reported by isTruncated().
+ */
+class TraceReader {
+public:
+    TraceReader();
+    ~TraceReader();
+
+    /**
+     * @brief Map a trace file
+     * @return false if it cannot be mapped or has no valid header
+     */
+    bool open(const char* path);
+
+    void close();
+
+    /**
+     * @brief Read the next event
+     * @return false at the end of the trace
+     */
+    bool next(TraceEvent& event);
+
+    /**
+     * @brief Restart from the first event
+     */
+    void rewind();
+
+    bool isTruncated() const;
+
+    size_t getFileSize() const;
+
+private:
+    const uint8_t* base;
+    size_t size;
+    size_t offset;
+    size_t data_start;
+    bool truncated;
+    bool mapped;
+    std::unique_ptr<uint8_t[]> fallback;
+
+    TraceReader(const TraceReader&) = delete;
+    TraceReader& operator=(const TraceReader&) = delete;
+};
+
+enum TracePacing {
+    TRACE_AS_FAST_AS_POSSIBLE,
+    TRACE_ORIGINAL_PACING
+};
+
+/**
+ * @brief Feed a trace back into a driver
+ *
+ * Receive events go to simulateReceive(), application writes to writeData()
+ * and transmit events to simulateTransmit(), in recorded order. With
+ * TRACE_ORIGINAL_PACING each event waits until its recorded offset from the
+ * first event has elapsed; otherwise events are replayed back to back.
+ * @return Number of events replayed
+ */
+template <typename Driver>
+uint64_t replayTrace(TraceReader& reader, Driver& uart, TracePacing pacing = TRACE_AS_FAST_AS_POSSIBLE) {
+    typedef std::chrono::steady_clock Clock;
+
+    uint64_t replayed = 0;
+    uint64_t first_ns = 0;
+    Clock::time_point start = Clock::now();
+    TraceEvent event;
+    while (reader.next(event)) {
+        if (pacing == TRACE_ORIGINAL_PACING) {
+            if (replayed == 0) {
+                first_ns = event.timestamp_ns;
+                start = Clock::now();
+            }
+            Clock::time_point due = start + std::chrono::nanoseconds(event.timestamp_ns - first_ns);
+            if (Clock::now() < due) {
+                std::this_thread::sleep_until(due);
+            }
+        }
+
+        switch (event.event) {
+            case TRACE_RX:
+                uart.simulateReceive(event.data, event.length);
+                break;
+            case TRACE_TX_WRITE:
+                uart.writeData(event.data, event.length);
+                break;
+            case TRACE_TX_DONE:
+                // The recorded count is what was sent, XON/XOFF included
+                uart.simulateTransmit(event.length);
+                break;
+            default:
+                break;
+        }
+        replayed++;
+    }
+    return replayed;
+}
+
+} // namespace uart
+
+#endif // UART_TRACE_H
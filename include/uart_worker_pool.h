@@ -0,0 +1,78 @@
+#ifndef UART_WORKER_POOL_H
+#define UART_WORKER_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace uart {
+
+/**
+ * @brief Fixed pool of worker threads with per-worker queues and stealing
+ *
+ * run() shards a batch of items (port indices) into contiguous slices, one
+ * per worker, so each worker touches a stable set of ports. A worker that
+ * finishes its slice steals from the far end of a busy worker's queue, so a
+ * few hot items cannot leave the rest of the pool idle. Each item is handled
+ * by exactly one worker per batch.
+ */
+class WorkerPool {
+public:
+    typedef std::function<void(size_t item)> Task;
+    
+    /**
+     * @param num_threads Worker count; 0 selects the hardware concurrency
+     */
+    explicit WorkerPool(size_t num_threads = 0);
+    ~WorkerPool();
+    
+    size_t size() const;
+    
+    /**
+     * @brief Run task(item) for every item and wait for completion
+     * Not reentrant: one batch at a time.
+     */
+    void run(const size_t* items, size_t count, const Task& task);
+    
+    /**
+     * @brief Number of items taken from another worker's queue so far
+     */
+    uint64_t getStealCount() const;
+    
+private:
+    struct Worker {
+        std::mutex lock;
+        std::deque<size_t> queue;
+        std::thread thread;
+    };
+    
+    size_t num_workers;
+    std::unique_ptr<Worker[]> workers;
+    
+    std::mutex state_lock;
+    std::condition_variable start_cv;
+    std::condition_variable done_cv;
+    uint64_t generation;
+    bool stopping;
+    const Task* current_task;
+    size_t busy_workers;
+    std::atomic<size_t> remaining;
+    std::atomic<uint64_t> steals;
+    
+    void workerLoop(size_t index);
+    bool takeOwn(size_t index, size_t& item);
+    bool steal(size_t index, size_t& item);
+    
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+};
+
+} // namespace uart
+
+#endif // UART_WORKER_POOL_H
@@ -0,0 +1,60 @@
+#include "uart_mapped_registers.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define UART_HAVE_MMAP 1
+#else
+#define UART_HAVE_MMAP 0
+#endif
+
+namespace uart {
+
+RegisterWindow::RegisterWindow()
+    : base(nullptr) {
+}
+
+RegisterWindow::~RegisterWindow() {
+    close();
+}
+
+bool RegisterWindow::open(const char* path) {
+    close();
+
+#if UART_HAVE_MMAP
+    int fd = ::open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 ||
+        (info.st_size < static_cast<off_t>(REGISTER_BLOCK_SIZE) &&
+         ftruncate(fd, static_cast<off_t>(REGISTER_BLOCK_SIZE)) != 0)) {
+        ::close(fd);
+        return false;
+    }
+    void* map = mmap(nullptr, REGISTER_BLOCK_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED) {
+        return false;
+    }
+    base = static_cast<volatile uint32_t*>(map);
+    return true;
+#else
+    (void)path;
+    return false;
+#endif
+}
+
+void RegisterWindow::close() {
+#if UART_HAVE_MMAP
+    if (base) {
+        munmap(const_cast<uint32_t*>(base), REGISTER_BLOCK_SIZE);
+    }
+#endif
+    base = nullptr;
+}
+
+} // namespace uart
@@ -6,7 +6,12 @@ UARTRegisters::UARTRegisters()
     : data_reg(0)
     , status_reg(STATUS_TX_EMPTY | STATUS_RX_EMPTY)  // FIFOs empty on reset
     , control_reg(0)
-    , baud_reg(0) {
+    , baud_reg(0)
+    , fifo_ctrl_reg(0)
+    , int_enable_reg(0)
+    , int_status_reg(0)
+    , status_provider(nullptr)
+    , status_context(nullptr) {
 }
 
 void UARTRegisters::writeRegister(uint32_t offset, uint32_t value) {
@@ -16,7 +21,7 @@ void UARTRegisters::writeRegister(uint32_t offset, uint32_t value) {
             break;
         case UART_STATUS_REG:
             // Status register is read-only except for error bits which are W1C (write-1-to-clear)
-            status_reg &= ~(value & (STATUS_FRAME_ERR | STATUS_OVERRUN));
+            status_reg.fetch_and(~(value & STATUS_ERROR_MASK), std::memory_order_relaxed);
             break;
         case UART_CONTROL_REG:
             control_reg = value;
@@ -24,6 +29,16 @@ void UARTRegisters::writeRegister(uint32_t offset, uint32_t value) {
         case UART_BAUD_REG:
             baud_reg = value;
             break;
+        case UART_FIFO_CTRL_REG:
+            fifo_ctrl_reg = value & (FCR_RX_TRIG_MASK | FCR_TX_LOW_MASK);
+            break;
+        case UART_INT_ENABLE_REG:
+            int_enable_reg = value & (INT_RX_TRIGGER | INT_TX_LOW | INT_LINE_ERROR);
+            break;
+        case UART_INT_STATUS_REG:
+            // Pending interrupts are W1C
+            int_status_reg.fetch_and(~value, std::memory_order_relaxed);
+            break;
         default:
             // Invalid register offset - ignore
             break;
@@ -35,26 +50,49 @@ uint32_t UARTRegisters::readRegister(uint32_t offset) const {
         case UART_DATA_REG:
             return data_reg;
         case UART_STATUS_REG:
-            return status_reg;
+            return readStatus();
         case UART_CONTROL_REG:
             return control_reg;
         case UART_BAUD_REG:
             return baud_reg;
+        case UART_FIFO_CTRL_REG:
+            return fifo_ctrl_reg;
+        case UART_INT_ENABLE_REG:
+            return int_enable_reg;
+        case UART_INT_STATUS_REG:
+            return int_status_reg.load(std::memory_order_relaxed);
         default:
             return 0;  // Invalid register reads return 0
     }
 }
 
 void UARTRegisters::setStatusBit(uint32_t bit) {
-    status_reg |= bit;
+    status_reg.fetch_or(bit, std::memory_order_relaxed);
 }
 
 void UARTRegisters::clearStatusBit(uint32_t bit) {
-    status_reg &= ~bit;
+    status_reg.fetch_and(~bit, std::memory_order_relaxed);
 }
 
 bool UARTRegisters::isStatusBitSet(uint32_t bit) const {
-    return (status_reg & bit) != 0;
+    // Error-only queries never need the FIFO state
+    if ((bit & STATUS_FIFO_MASK) == 0) {
+        return (status_reg.load(std::memory_order_relaxed) & bit) != 0;
+    }
+    return (readStatus() & bit) != 0;
+}
+
+void UARTRegisters::setStatusProvider(StatusProvider provider, const void* context) {
+    status_provider = provider;
+    status_context = context;
+}
+
+uint32_t UARTRegisters::readStatus() const {
+    uint32_t status = status_reg.load(std::memory_order_relaxed);
+    if (status_provider) {
+        status = (status & ~STATUS_FIFO_MASK) | status_provider(status_context);
+    }
+    return status;
 }
 
 bool UARTRegisters::isEnabled() const {
@@ -77,11 +115,38 @@ bool UARTRegisters::isParityOdd() const {
     return (control_reg & CTRL_PARITY_ODD) != 0;
 }
 
+bool UARTRegisters::isTwoStopBits() const {
+    return (control_reg & CTRL_TWO_STOP) != 0;
+}
+
+uint32_t UARTRegisters::getBaudRate() const {
+    return baud_reg;
+}
+
+void UARTRegisters::setInterruptPending(uint32_t bits) {
+    int_status_reg.fetch_or(bits, std::memory_order_relaxed);
+}
+
+uint32_t UARTRegisters::getInterruptPending() const {
+    return int_status_reg.load(std::memory_order_relaxed);
+}
+
+uint32_t UARTRegisters::getInterruptEnable() const {
+    return int_enable_reg;
+}
+
+uint32_t UARTRegisters::getFifoControl() const {
+    return fifo_ctrl_reg;
+}
+
 void UARTRegisters::reset() {
     data_reg = 0;
-    status_reg = STATUS_TX_EMPTY | STATUS_RX_EMPTY;
+    status_reg.store(STATUS_TX_EMPTY | STATUS_RX_EMPTY, std::memory_order_relaxed);
     control_reg = 0;
     baud_reg = 0;
+    fifo_ctrl_reg = 0;
+    int_enable_reg = 0;
+    int_status_reg.store(0, std::memory_order_relaxed);
 }
 
 } // namespace uart
@@ -0,0 +1,266 @@
+#include "uart_trace.h"
+#include <cstring>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define UART_TRACE_HAVE_MMAP 1
+#else
+#define UART_TRACE_HAVE_MMAP 0
+#endif
+
+namespace uart {
+
+namespace {
+
+const char TRACE_MAGIC[8] = {'U', 'A', 'R', 'T', 'T', 'R', 'C', '\0'};
+const uint8_t TRACE_PADDING[8] = {0};
+
+size_t paddingFor(size_t length) {
+    return (8 - (length & 7)) & 7;
+}
+
+} // namespace
+
+constexpr size_t TraceRecorder::BUFFER_SIZE;
+
+TraceRecorder::TraceRecorder()
+    : file(nullptr)
+    , used(0)
+    , failed(false)
+    , records(0) {
+}
+
+TraceRecorder::~TraceRecorder() {
+    close();
+}
+
+bool TraceRecorder::open(const char* path) {
+    close();
+
+    std::lock_guard<std::mutex> guard(lock);
+    file = std::fopen(path, "wb");
+    if (!file) {
+        return false;
+    }
+    if (!buffer) {
+        buffer.reset(new uint8_t[BUFFER_SIZE]);
+    }
+    used = 0;
+    failed = false;
+    records = 0;
+    start = std::chrono::steady_clock::now();
+
+    TraceFileHeader header;
+    memcpy(header.magic, TRACE_MAGIC, sizeof(header.magic));
+    header.version = TRACE_FORMAT_VERSION;
+    header.header_size = sizeof(TraceFileHeader);
+    appendLocked(&header, sizeof(header));
+    return true;
+}
+
+bool TraceRecorder::close() {
+    std::lock_guard<std::mutex> guard(lock);
+    if (!file) {
+        return !failed;
+    }
+    flushLocked();
+    if (std::fclose(file) != 0) {
+        failed = true;
+    }
+    file = nullptr;
+    return !failed;
+}
+
+bool TraceRecorder::isOpen() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return file != nullptr;
+}
+
+void TraceRecorder::record(uint32_t event, const uint8_t* data, size_t length) {
+    uint64_t now = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count());
+
+    TraceRecordHeader header;
+    header.timestamp_ns = now;
+    header.event = static_cast<uint8_t>(event);
+    memset(header.reserved, 0, sizeof(header.reserved));
+
+    std::lock_guard<std::mutex> guard(lock);
+    if (!file) {
+        return;
+    }
+    // The length field is 32 bits: larger events become consecutive records
+    // with the same timestamp, which replay the same way
+    do {
+        size_t part = (length > TRACE_MAX_RECORD_LENGTH) ? TRACE_MAX_RECORD_LENGTH : length;
+        size_t payload = (event == TRACE_TX_DONE) ? 0 : part;
+        header.length = static_cast<uint32_t>(part);
+        appendLocked(&header, sizeof(header));
+        appendLocked(data, payload);
+        appendLocked(TRACE_PADDING, paddingFor(payload));
+        records++;
+        if (data && payload) {
+            data += payload;
+        }
+        length -= part;
+    } while (length > 0);
+}
+
+uint64_t TraceRecorder::getRecordCount() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return records;
+}
+
+void TraceRecorder::onEvent(uint32_t event, const uint8_t* data, size_t length, void* context) {
+    static_cast<TraceRecorder*>(context)->record(event, data, length);
+}
+
+void TraceRecorder::flushLocked() {
+    if (used > 0 && std::fwrite(buffer.get(), 1, used, file) != used) {
+        failed = true;
+    }
+    used = 0;
+}
+
+void TraceRecorder::appendLocked(const void* data, size_t length) {
+    if (length == 0) {
+        return;
+    }
+    if (length > BUFFER_SIZE - used) {
+        flushLocked();
+        if (length > BUFFER_SIZE) {
+            // Oversized payload: write it through
+            if (std::fwrite(data, 1, length, file) != length) {
+                failed = true;
+            }
+            return;
+        }
+    }
+    memcpy(buffer.get() + used, data, length);
+    used += length;
+}
+
+TraceReader::TraceReader()
+    : base(nullptr)
+    , size(0)
+    , offset(0)
+    , data_start(0)
+    , truncated(false)
+    , mapped(false) {
+}
+
+TraceReader::~TraceReader() {
+    close();
+}
+
+bool TraceReader::open(const char* path) {
+    close();
+
+#if UART_TRACE_HAVE_MMAP
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(TraceFileHeader))) {
+        ::close(fd);
+        return false;
+    }
+    size_t length = static_cast<size_t>(info.st_size);
+    void* map = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED) {
+        return false;
+    }
+    madvise(map, length, MADV_SEQUENTIAL);
+    base = static_cast<const uint8_t*>(map);
+    size = length;
+    mapped = true;
+#else
+    std::FILE* file = std::fopen(path, "rb");
+    if (!file) {
+        return false;
+    }
+    std::fseek(file, 0, SEEK_END);
+    long length = std::ftell(file);
+    std::fseek(file, 0, SEEK_SET);
+    if (length < static_cast<long>(sizeof(TraceFileHeader))) {
+        std::fclose(file);
+        return false;
+    }
+    fallback.reset(new uint8_t[length]);
+    size_t got = std::fread(fallback.get(), 1, static_cast<size_t>(length), file);
+    std::fclose(file);
+    base = fallback.get();
+    size = got;
+#endif
+
+    TraceFileHeader header;
+    memcpy(&header, base, sizeof(header));
+    if (memcmp(header.magic, TRACE_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != TRACE_FORMAT_VERSION || header.header_size < sizeof(TraceFileHeader) ||
+        header.header_size > size) {
+        close();
+        return false;
+    }
+    data_start = header.header_size;
+    offset = data_start;
+    return true;
+}
+
+void TraceReader::close() {
+#if UART_TRACE_HAVE_MMAP
+    if (mapped) {
+        munmap(const_cast<uint8_t*>(base), size);
+    }
+#endif
+    fallback.reset();
+    base = nullptr;
+    size = 0;
+    offset = 0;
+    data_start = 0;
+    truncated = false;
+    mapped = false;
+}
+
+bool TraceReader::next(TraceEvent& event) {
+    if (!base || size - offset < sizeof(TraceRecordHeader)) {
+        truncated = base && offset != size;
+        return false;
+    }
+    const TraceRecordHeader* header = reinterpret_cast<const TraceRecordHeader*>(base + offset);
+    bool has_payload = header->event != TRACE_TX_DONE;
+    size_t payload = has_payload ? header->length : 0;
+    size_t record_size = sizeof(TraceRecordHeader) + payload + paddingFor(payload);
+    if (record_size > size - offset) {
+        truncated = true;
+        return false;
+    }
+
+    event.timestamp_ns = header->timestamp_ns;
+    event.event = header->event;
+    event.length = header->length;
+    event.data = has_payload ? base + offset + sizeof(TraceRecordHeader) : nullptr;
+    offset += record_size;
+    return true;
+}
+
+void TraceReader::rewind() {
+    if (base) {
+        offset = data_start;
+        truncated = false;
+    }
+}
+
+bool TraceReader::isTruncated() const {
+    return truncated;
+}
+
+size_t TraceReader::getFileSize() const {
+    return size;
+}
+
+} // namespace uart
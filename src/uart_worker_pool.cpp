@@ -0,0 +1,131 @@
+#include "uart_worker_pool.h"
+
+namespace uart {
+
+WorkerPool::WorkerPool(size_t num_threads)
+    : num_workers(num_threads)
+    , generation(0)
+    , stopping(false)
+    , current_task(nullptr)
+    , busy_workers(0)
+    , remaining(0)
+    , steals(0) {
+    if (num_workers == 0) {
+        num_workers = std::thread::hardware_concurrency();
+        if (num_workers == 0) {
+            num_workers = 1;
+        }
+    }
+    
+    workers.reset(new Worker[num_workers]);
+    for (size_t i = 0; i < num_workers; i++) {
+        workers[i].thread = std::thread(&WorkerPool::workerLoop, this, i);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> guard(state_lock);
+        stopping = true;
+    }
+    start_cv.notify_all();
+    for (size_t i = 0; i < num_workers; i++) {
+        workers[i].thread.join();
+    }
+}
+
+size_t WorkerPool::size() const {
+    return num_workers;
+}
+
+void WorkerPool::run(const size_t* items, size_t count, const Task& task) {
+    if (!items || count == 0) {
+        return;
+    }
+    
+    std::unique_lock<std::mutex> guard(state_lock);
+    
+    // A worker that woke late for the previous batch must leave it first
+    done_cv.wait(guard, [this]() { return busy_workers == 0; });
+    
+    // Contiguous shards keep each worker on the same ports between batches
+    size_t shard = (count + num_workers - 1) / num_workers;
+    for (size_t w = 0; w < num_workers; w++) {
+        std::lock_guard<std::mutex> queue_guard(workers[w].lock);
+        size_t begin = w * shard;
+        size_t end = (begin + shard < count) ? begin + shard : count;
+        for (size_t i = begin; i < end; i++) {
+            workers[w].queue.push_back(items[i]);
+        }
+    }
+    
+    remaining.store(count, std::memory_order_relaxed);
+    current_task = &task;
+    generation++;
+    start_cv.notify_all();
+    
+    done_cv.wait(guard, [this]() {
+        return remaining.load(std::memory_order_acquire) == 0 && busy_workers == 0;
+    });
+    current_task = nullptr;
+}
+
+uint64_t WorkerPool::getStealCount() const {
+    return steals.load(std::memory_order_relaxed);
+}
+
+void WorkerPool::workerLoop(size_t index) {
+    uint64_t seen = 0;
+    for (;;) {
+        const Task* task;
+        {
+            std::unique_lock<std::mutex> guard(state_lock);
+            start_cv.wait(guard, [this, seen]() { return stopping || generation != seen; });
+            if (stopping) {
+                return;
+            }
+            seen = generation;
+            task = current_task;
+            busy_workers++;
+        }
+        
+        size_t item;
+        while (takeOwn(index, item) || steal(index, item)) {
+            (*task)(item);
+            remaining.fetch_sub(1, std::memory_order_acq_rel);
+        }
+        
+        std::lock_guard<std::mutex> guard(state_lock);
+        if (--busy_workers == 0) {
+            done_cv.notify_all();
+        }
+    }
+}
+
+bool WorkerPool::takeOwn(size_t index, size_t& item) {
+    Worker& self = workers[index];
+    std::lock_guard<std::mutex> guard(self.lock);
+    if (self.queue.empty()) {
+        return false;
+    }
+    item = self.queue.front();
+    self.queue.pop_front();
+    return true;
+}
+
+bool WorkerPool::steal(size_t index, size_t& item) {
+    for (size_t offset = 1; offset < num_workers; offset++) {
+        Worker& victim = workers[(index + offset) % num_workers];
+        std::lock_guard<std::mutex> guard(victim.lock);
+        if (!victim.queue.empty()) {
+            // Take from the far end so the owner keeps its cache-warm ports
+            item = victim.queue.back();
+            victim.queue.pop_back();
+            steals.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace uart
@@ -0,0 +1,117 @@
+#include "uart_stress.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+/**
+ * uart_stress - randomized differential testing against a reference model
+ *
+ * Runs random operation sequences on every hardware thread, comparing the
+ * driver with ReferenceUART after each step, for the default 16/16 FIFO
+ * driver and an uneven 4/8 one. The first failure is shrunk and printed
+ * with the command that replays it.
+ *
+ * Usage: uart_stress [--seed N] [--seconds S] [--sequences N] [--threads N]
+ *                    [--max-ops N] [--replay INDEX]
+ */
+
+using namespace uart;
+using namespace uart::stress;
+
+namespace {
+
+typedef BasicUARTDriver<4, 8> SmallUARTDriver;
+
+void printSequence(const std::vector<StressOperation>& ops) {
+    char text[64];
+    for (size_t i = 0; i < ops.size(); i++) {
+        formatStressOp(ops[i], text, sizeof(text));
+        printf("    %3zu: %s\n", i, text);
+    }
+}
+
+template <typename Driver>
+bool stressDriver(const char* name, const StressConfig& config) {
+    StressResult result = runStress<Driver>(config);
+    double rate = result.seconds > 0.0 ? result.operations / result.seconds : 0.0;
+    printf("%-10s %llu sequences, %llu operations in %.2f s on %zu threads (%.2f M ops/s)\n",
+           name, static_cast<unsigned long long>(result.sequences),
+           static_cast<unsigned long long>(result.operations), result.seconds, result.threads, rate / 1e6);
+    if (!result.failed) {
+        return true;
+    }
+
+    printf("FAILED: sequence %llu of seed %llu (%zu operations, shrunk to %zu in %zu replays)\n",
+           static_cast<unsigned long long>(result.failing_index),
+           static_cast<unsigned long long>(config.seed),
+           result.original_length, result.failing_ops.size(), result.shrink_replays);
+    printSequence(result.failing_ops);
+    printf("  step %zu: %s\n", result.mismatch.step, result.mismatch.what);
+    printf("  replay: uart_stress --seed %llu --replay %llu\n",
+           static_cast<unsigned long long>(config.seed),
+           static_cast<unsigned long long>(result.failing_index));
+    return false;
+}
+
+template <typename Driver>
+bool replayDriver(const char* name, const StressConfig& config, uint64_t index) {
+    std::vector<StressOperation> ops;
+    generateStressSequence(sequenceSeed(config.seed, index), config.max_ops, config.max_length, ops);
+    StressBuffers buffers;
+    StressMismatch mismatch;
+    bool passed = runStressSequence<Driver>(ops.data(), ops.size(), buffers, mismatch);
+    printf("%-10s sequence %llu: %s\n", name, static_cast<unsigned long long>(index),
+           passed ? "passed" : "FAILED");
+    printSequence(ops);
+    if (!passed) {
+        printf("  step %zu: %s\n", mismatch.step, mismatch.what);
+    }
+    return passed;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    StressConfig config;
+    bool replay = false;
+    uint64_t replay_index = 0;
+    for (int i = 1; i < argc; i++) {
+        bool has_value = i + 1 < argc;
+        if (strcmp(argv[i], "--seed") == 0 && has_value) {
+            config.seed = strtoull(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--seconds") == 0 && has_value) {
+            config.seconds = strtod(argv[++i], nullptr);
+        } else if (strcmp(argv[i], "--sequences") == 0 && has_value) {
+            config.sequences = strtoull(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--threads") == 0 && has_value) {
+            config.threads = static_cast<size_t>(strtoul(argv[++i], nullptr, 10));
+        } else if (strcmp(argv[i], "--max-ops") == 0 && has_value) {
+            config.max_ops = static_cast<size_t>(strtoul(argv[++i], nullptr, 10));
+        } else if (strcmp(argv[i], "--replay") == 0 && has_value) {
+            replay = true;
+            replay_index = strtoull(argv[++i], nullptr, 10);
+        } else {
+            fprintf(stderr, "usage: %s [--seed N] [--seconds S] [--sequences N] [--threads N]"
+                            " [--max-ops N] [--replay INDEX]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (config.seconds <= 0.0 && config.sequences == 0) {
+        fprintf(stderr, "%s: set --seconds or --sequences\n", argv[0]);
+        return 2;
+    }
+
+    bool passed = true;
+    if (replay) {
+        passed = replayDriver<UARTDriver>("fifo16", config, replay_index) && passed;
+        passed = replayDriver<SmallUARTDriver>("fifo4x8", config, replay_index) && passed;
+        return passed ? 0 : 1;
+    }
+
+    // Split the time budget between the two drivers
+    config.seconds /= 2;
+    printf("seed %llu\n", static_cast<unsigned long long>(config.seed));
+    passed = stressDriver<UARTDriver>("fifo16", config) && passed;
+    passed = stressDriver<SmallUARTDriver>("fifo4x8", config) && passed;
+    return passed ? 0 : 1;
+}
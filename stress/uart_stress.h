@@ -0,0 +1,656 @@
+#ifndef UART_STRESS_H
+#define UART_STRESS_H
+
+#include "uart_driver.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <thread>
+#include <vector>
+
+namespace uart {
+namespace stress {
+
+/**
+ * Randomized differential testing of the driver against ReferenceUART.
+ *
+ * A sequence is a list of StressOperation values generated from a 64-bit
+ * seed. Each one is run on a freshly constructed driver and on the model;
+ * after every step the return value, any bytes read, both FIFO counts, the
+ * status register and the status queries must agree. Sequence i of a run
+ * uses sequenceSeed(seed, i), so a failure reproduces from (seed, i) no
+ * matter how many threads found it. Failing sequences are shrunk to a
+ * locally minimal one before they are reported.
+ */
+enum StressOpKind {
+    STRESS_WRITE_BYTE,
+    STRESS_WRITE_DATA,
+    STRESS_READ_BYTE,
+    STRESS_READ_DATA,
+    STRESS_READ_UNTIL,
+    STRESS_RECEIVE,
+    STRESS_TRANSMIT,
+    STRESS_CLEAR_ERRORS,
+    STRESS_SHUTDOWN,
+    STRESS_INITIALIZE,
+    STRESS_OP_COUNT
+};
+
+struct StressOperation {
+    uint8_t kind;       // StressOpKind
+    uint8_t value;      // Byte value, data pattern or delimiter selector
+    uint16_t length;    // Byte count for the bulk operations
+};
+
+inline bool operator==(const StressOperation& a, const StressOperation& b) {
+    return a.kind == b.kind && a.value == b.value && a.length == b.length;
+}
+
+inline const char* stressOpName(uint8_t kind) {
+    switch (kind) {
+        case STRESS_WRITE_BYTE:   return "writeByte";
+        case STRESS_WRITE_DATA:   return "writeData";
+        case STRESS_READ_BYTE:    return "readByte";
+        case STRESS_READ_DATA:    return "readData";
+        case STRESS_READ_UNTIL:   return "readUntil";
+        case STRESS_RECEIVE:      return "simulateReceive";
+        case STRESS_TRANSMIT:     return "drainTx";
+        case STRESS_CLEAR_ERRORS: return "clearErrors";
+        case STRESS_SHUTDOWN:     return "shutdown";
+        case STRESS_INITIALIZE:   return "initialize";
+        default:                  return "unknown";
+    }
+}
+
+/**
+ * @brief Format one operation as it would be written in a test
+ */
+inline void formatStressOp(const StressOperation& op, char* text, size_t size) {
+    switch (op.kind) {
+        case STRESS_WRITE_BYTE:
+            snprintf(text, size, "writeByte(0x%02x)", op.value);
+            break;
+        case STRESS_WRITE_DATA:
+        case STRESS_RECEIVE:
+            snprintf(text, size, "%s(pattern %u, %u bytes)", stressOpName(op.kind), op.value, op.length);
+            break;
+        case STRESS_READ_DATA:
+        case STRESS_TRANSMIT:
+            snprintf(text, size, "%s(max %u)", stressOpName(op.kind), op.length);
+            break;
+        case STRESS_READ_UNTIL:
+            snprintf(text, size, "readUntil('%c', max %u)", 'a' + (op.value & 7), op.length);
+            break;
+        default:
+            snprintf(text, size, "%s()", stressOpName(op.kind));
+            break;
+    }
+}
+
+// Payload of a write or receive: a small alphabet, so readUntil delimiters occur
+inline void fillStressPattern(uint8_t* data, size_t length, uint8_t pattern) {
+    for (size_t i = 0; i < length; i++) {
+        data[i] = static_cast<uint8_t>('a' + ((pattern + i * 3) & 7));
+    }
+}
+
+inline uint64_t splitMix64(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+inline uint64_t sequenceSeed(uint64_t seed, uint64_t index) {
+    return splitMix64(seed ^ splitMix64(index));
+}
+
+/**
+ * @brief Generate the sequence for one seed
+ * @param max_ops Sequences have 1..max_ops operations
+ * @param max_length Bulk lengths are 0..max_length bytes
+ */
+inline void generateStressSequence(uint64_t seed, size_t max_ops, size_t max_length,
+                                   std::vector<StressOperation>& ops) {
+    // Out of 64: data movement dominates, resets are rare
+    static const uint8_t weights[STRESS_OP_COUNT] = {8, 8, 8, 8, 6, 10, 10, 3, 1, 2};
+
+    uint64_t state = splitMix64(seed) | 1;
+    uint64_t count = 1 + state % (max_ops ? max_ops : 1);
+    ops.resize(static_cast<size_t>(count));
+    for (size_t i = 0; i < ops.size(); i++) {
+        // xorshift64*
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        uint64_t r = state * 0x2545F4914F6CDD1Dull;
+
+        uint32_t pick = static_cast<uint32_t>(r >> 58);
+        uint8_t kind = 0;
+        while (pick >= weights[kind]) {
+            pick -= weights[kind];
+            kind++;
+        }
+        ops[i].kind = kind;
+        ops[i].value = static_cast<uint8_t>(r >> 8);
+        ops[i].length = static_cast<uint16_t>((r >> 16) % (max_length + 1));
+    }
+}
+
+/**
+ * @brief Trivially correct model of the driver's FIFO data path
+ *
+ * Two bounded queues, an enable flag and the sticky overrun bit; no
+ * watermarks, interrupts, flow control or software buffers.
+ */
+class ReferenceUART {
+public:
+    ReferenceUART(size_t tx_depth, size_t rx_depth)
+        : tx_depth(tx_depth)
+        , rx_depth(rx_depth)
+        , enabled(false)
+        , overrun(false) {
+    }
+
+    void initialize() {
+        enabled = true;
+        overrun = false;
+        tx.clear();
+        rx.clear();
+    }
+
+    void shutdown() {
+        enabled = false;
+        tx.clear();
+        rx.clear();
+    }
+
+    bool writeByte(uint8_t data) {
+        if (!enabled || tx.size() >= tx_depth) {
+            return false;
+        }
+        tx.push_back(data);
+        return true;
+    }
+
+    size_t writeData(const uint8_t* data, size_t length) {
+        size_t queued = 0;
+        while (queued < length && writeByte(data[queued])) {
+            queued++;
+        }
+        return queued;
+    }
+
+    bool readByte(uint8_t& data) {
+        if (!enabled || rx.empty()) {
+            return false;
+        }
+        data = rx.front();
+        rx.pop_front();
+        return true;
+    }
+
+    size_t readData(uint8_t* buffer, size_t max_length) {
+        size_t read = 0;
+        while (read < max_length && readByte(buffer[read])) {
+            read++;
+        }
+        return read;
+    }
+
+    bool readUntil(uint8_t delimiter, uint8_t* buffer, size_t max_length, size_t& length) {
+        length = 0;
+        if (!enabled) {
+            return false;
+        }
+        size_t limit = std::min(rx.size(), max_length);
+        for (size_t i = 0; i < limit; i++) {
+            if (rx[i] == delimiter) {
+                length = readData(buffer, i + 1);
+                return true;
+            }
+        }
+        if (max_length > 0 && rx.size() >= max_length) {
+            length = readData(buffer, max_length);
+        }
+        return false;
+    }
+
+    size_t receive(const uint8_t* data, size_t length) {
+        if (!enabled) {
+            return 0;
+        }
+        for (size_t i = 0; i < length; i++) {
+            if (rx.size() >= rx_depth) {
+                overrun = true;
+                return i;
+            }
+            rx.push_back(data[i]);
+        }
+        return length;
+    }
+
+    size_t transmit(uint8_t* out, size_t max_length) {
+        if (!enabled) {
+            return 0;
+        }
+        size_t sent = 0;
+        while (sent < max_length && !tx.empty()) {
+            out[sent++] = tx.front();
+            tx.pop_front();
+        }
+        return sent;
+    }
+
+    void clearErrors() { overrun = false; }
+
+    uint32_t status() const {
+        uint32_t status = overrun ? STATUS_OVERRUN : 0;
+        if (tx.empty()) {
+            status |= STATUS_TX_EMPTY;
+        } else if (tx.size() >= tx_depth) {
+            status |= STATUS_TX_FULL;
+        }
+        if (rx.empty()) {
+            status |= STATUS_RX_EMPTY;
+        } else if (rx.size() >= rx_depth) {
+            status |= STATUS_RX_FULL;
+        }
+        return status;
+    }
+
+    size_t txCount() const { return tx.size(); }
+    size_t rxCount() const { return rx.size(); }
+    bool canTransmit() const { return enabled && tx.size() < tx_depth; }
+    bool hasData() const { return enabled && !rx.empty(); }
+    bool hasError() const { return overrun; }
+
+private:
+    size_t tx_depth;
+    size_t rx_depth;
+    bool enabled;
+    bool overrun;
+    std::deque<uint8_t> tx;
+    std::deque<uint8_t> rx;
+};
+
+/**
+ * @brief First point where the driver and the model disagreed
+ */
+struct StressMismatch {
+    size_t step;
+    char what[128];
+};
+
+// Scratch buffers reused across sequences by one thread
+struct StressBuffers {
+    std::vector<uint8_t> input;
+    std::vector<uint8_t> driver_out;
+    std::vector<uint8_t> model_out;
+
+    void reserve(size_t length) {
+        if (input.size() < length) {
+            input.resize(length);
+            driver_out.resize(length);
+            model_out.resize(length);
+        }
+    }
+};
+
+namespace detail {
+
+inline bool differs(StressMismatch& mismatch, size_t step, const StressOperation& op,
+                    const char* what, size_t actual, size_t expected) {
+    char text[64];
+    formatStressOp(op, text, sizeof(text));
+    mismatch.step = step;
+    snprintf(mismatch.what, sizeof(mismatch.what), "%s: %s is %zu, model has %zu",
+             text, what, actual, expected);
+    return false;
+}
+
+} // namespace detail
+
+/**
+ * @brief Run one sequence on a fresh driver and the model
+ * @return true if they agreed at every step; otherwise mismatch says where
+ */
+template <typename Driver>
+bool runStressSequence(const StressOperation* ops, size_t count, StressBuffers& buffers,
+                       StressMismatch& mismatch) {
+    using detail::differs;
+
+    size_t longest = 1;
+    for (size_t i = 0; i < count; i++) {
+        longest = std::max<size_t>(longest, ops[i].length);
+    }
+    buffers.reserve(longest);
+    uint8_t* input = buffers.input.data();
+    uint8_t* got = buffers.driver_out.data();
+    uint8_t* want = buffers.model_out.data();
+
+    Driver uart;
+    ReferenceUART model(Driver::TX_FIFO_DEPTH, Driver::RX_FIFO_DEPTH);
+    uart.initialize(115200);
+    model.initialize();
+
+    for (size_t step = 0; step < count; step++) {
+        const StressOperation& op = ops[step];
+        size_t length = op.length;
+        size_t actual = 0;
+        size_t expected = 0;
+        bool compare_bytes = false;
+
+        switch (op.kind) {
+            case STRESS_WRITE_BYTE:
+                actual = uart.writeByte(op.value);
+                expected = model.writeByte(op.value);
+                break;
+            case STRESS_WRITE_DATA:
+                fillStressPattern(input, length, op.value);
+                actual = uart.writeData(input, length);
+                expected = model.writeData(input, length);
+                break;
+            case STRESS_READ_BYTE: {
+                got[0] = 0;
+                want[0] = 0;
+                actual = uart.readByte(got[0]);
+                expected = model.readByte(want[0]);
+                compare_bytes = true;
+                length = actual;
+                break;
+            }
+            case STRESS_READ_DATA:
+                actual = uart.readData(got, length);
+                expected = model.readData(want, length);
+                compare_bytes = true;
+                break;
+            case STRESS_READ_UNTIL: {
+                uint8_t delimiter = static_cast<uint8_t>('a' + (op.value & 7));
+                size_t got_length = 0;
+                size_t want_length = 0;
+                bool found = uart.readUntil(delimiter, got, length, got_length);
+                if (found != model.readUntil(delimiter, want, length, want_length)) {
+                    return differs(mismatch, step, op, "found", found, !found);
+                }
+                actual = got_length;
+                expected = want_length;
+                compare_bytes = true;
+                break;
+            }
+            case STRESS_RECEIVE: {
+                fillStressPattern(input, length, op.value);
+                ReceiveResult received = uart.simulateReceive(input, length);
+                if (received.accepted + received.dropped != length) {
+                    return differs(mismatch, step, op, "accepted + dropped",
+                                   received.accepted + received.dropped, length);
+                }
+                actual = received.accepted;
+                expected = model.receive(input, length);
+                break;
+            }
+            case STRESS_TRANSMIT:
+                actual = uart.drainTx(got, length);
+                expected = model.transmit(want, length);
+                compare_bytes = true;
+                break;
+            case STRESS_CLEAR_ERRORS:
+                uart.clearErrors();
+                model.clearErrors();
+                break;
+            case STRESS_SHUTDOWN:
+                uart.shutdown();
+                model.shutdown();
+                break;
+            case STRESS_INITIALIZE:
+                uart.initialize(115200);
+                model.initialize();
+                break;
+            default:
+                break;
+        }
+
+        if (actual != expected) {
+            return differs(mismatch, step, op, "result", actual, expected);
+        }
+        if (compare_bytes && actual > 0 && memcmp(got, want, actual) != 0) {
+            size_t at = 0;
+            while (got[at] == want[at]) {
+                at++;
+            }
+            return differs(mismatch, step, op, "byte value", got[at], want[at]);
+        }
+        if (uart.getTxFifoCount() != model.txCount()) {
+            return differs(mismatch, step, op, "TX FIFO count", uart.getTxFifoCount(), model.txCount());
+        }
+        if (uart.getRxFifoCount() != model.rxCount()) {
+            return differs(mismatch, step, op, "RX FIFO count", uart.getRxFifoCount(), model.rxCount());
+        }
+        uint32_t status = uart.readStatus() & (STATUS_FIFO_MASK | STATUS_ERROR_MASK);
+        if (status != model.status()) {
+            return differs(mismatch, step, op, "status", status, model.status());
+        }
+        if (uart.canTransmit() != model.canTransmit()) {
+            return differs(mismatch, step, op, "canTransmit", uart.canTransmit(), model.canTransmit());
+        }
+        if (uart.hasData() != model.hasData()) {
+            return differs(mismatch, step, op, "hasData", uart.hasData(), model.hasData());
+        }
+        if (uart.hasError() != model.hasError()) {
+            return differs(mismatch, step, op, "hasError", uart.hasError(), model.hasError());
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Shrink a failing sequence while it keeps failing
+ *
+ * Cuts everything after the failing step, removes runs of operations in
+ * halving chunk sizes, then lowers lengths and values, until no single
+ * change still fails. The result need not fail the same way as the input,
+ * only fail.
+ * @return Number of sequences replayed while shrinking
+ */
+template <typename Driver>
+size_t shrinkStressSequence(std::vector<StressOperation>& ops, StressMismatch& mismatch) {
+    StressBuffers buffers;
+    std::vector<StressOperation> candidate;
+    size_t replays = 0;
+
+    if (runStressSequence<Driver>(ops.data(), ops.size(), buffers, mismatch)) {
+        return 0;  // Not failing; nothing to shrink
+    }
+    ops.resize(mismatch.step + 1);
+
+    bool progress = true;
+    while (progress) {
+        progress = false;
+
+        // Drop runs of operations
+        for (size_t chunk = ops.size() / 2; chunk >= 1; chunk /= 2) {
+            size_t start = 0;
+            while (start < ops.size() && ops.size() > 1) {
+                size_t end = std::min(start + chunk, ops.size());
+                candidate.assign(ops.begin(), ops.begin() + start);
+                candidate.insert(candidate.end(), ops.begin() + end, ops.end());
+                StressMismatch attempt;
+                replays++;
+                if (!candidate.empty() &&
+                    !runStressSequence<Driver>(candidate.data(), candidate.size(), buffers, attempt)) {
+                    candidate.resize(attempt.step + 1);
+                    ops.swap(candidate);
+                    mismatch = attempt;
+                    progress = true;
+                } else {
+                    start += chunk;
+                }
+            }
+        }
+
+        // Simplify the operations that are left
+        for (size_t i = 0; i < ops.size(); i++) {
+            const StressOperation original = ops[i];
+            StressOperation simpler[3] = {original, original, original};
+            simpler[0].length = 0;
+            simpler[1].length = static_cast<uint16_t>(original.length / 2);
+            simpler[2].value = 0;
+            for (size_t s = 0; s < 3; s++) {
+                if (simpler[s] == ops[i]) {
+                    continue;
+                }
+                candidate = ops;
+                candidate[i] = simpler[s];
+                StressMismatch attempt;
+                replays++;
+                if (!runStressSequence<Driver>(candidate.data(), candidate.size(), buffers, attempt)) {
+                    candidate.resize(attempt.step + 1);
+                    ops.swap(candidate);
+                    mismatch = attempt;
+                    progress = true;
+                    break;
+                }
+            }
+            if (i >= ops.size()) {
+                break;
+            }
+        }
+    }
+    return replays;
+}
+
+struct StressConfig {
+    uint64_t seed;
+    uint64_t sequences;     // Stop after this many (0: no limit)
+    double seconds;         // Stop after this long (0: no limit)
+    size_t threads;         // 0: one per hardware thread
+    size_t max_ops;
+    size_t max_length;
+
+    StressConfig()
+        : seed(1)
+        , sequences(0)
+        , seconds(10.0)
+        , threads(0)
+        , max_ops(64)
+        , max_length(2 * FIFO_DEPTH + 8) {
+    }
+};
+
+struct StressResult {
+    uint64_t sequences;             // Sequences run
+    uint64_t operations;            // Operations run
+    double seconds;                 // Wall time
+    size_t threads;
+    bool failed;
+    uint64_t failing_index;         // Lowest failing sequence index
+    size_t original_length;         // Its length before shrinking
+    size_t shrink_replays;
+    std::vector<StressOperation> failing_ops;   // Shrunk sequence
+    StressMismatch mismatch;        // How the shrunk sequence fails
+};
+
+/**
+ * @brief Run random sequences on all threads until a limit or a failure
+ *
+ * Thread t runs sequence indices t, t + threads, ... in order. The first
+ * failure stops every thread once it passes that index, so the reported
+ * failure is always the lowest failing index among those reached, and
+ * rerunning with the same seed finds the same one.
+ */
+template <typename Driver>
+StressResult runStress(const StressConfig& config) {
+    typedef std::chrono::steady_clock Clock;
+
+    size_t threads = config.threads;
+    if (threads == 0) {
+        threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+    const uint64_t no_failure = ~static_cast<uint64_t>(0);
+    std::atomic<uint64_t> first_failure(no_failure);
+    std::atomic<uint64_t> sequences(0);
+    std::atomic<uint64_t> operations(0);
+    std::atomic<bool> expired(false);
+    Clock::time_point start = Clock::now();
+    Clock::time_point deadline = start + std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(config.seconds));
+
+    struct Worker {
+        static void run(const StressConfig& config, size_t shard, size_t stride,
+                        std::atomic<uint64_t>& first_failure, std::atomic<uint64_t>& sequences,
+                        std::atomic<uint64_t>& operations, std::atomic<bool>& expired,
+                        Clock::time_point deadline) {
+            StressBuffers buffers;
+            std::vector<StressOperation> ops;
+            StressMismatch mismatch;
+            uint64_t run = 0;
+            uint64_t ops_run = 0;
+            for (uint64_t index = shard; ; index += stride) {
+                if (config.sequences && index >= config.sequences) {
+                    break;
+                }
+                if (index > first_failure.load(std::memory_order_relaxed)) {
+                    break;
+                }
+                if ((run & 255) == 0 && config.seconds > 0.0) {
+                    if (expired.load(std::memory_order_relaxed) || Clock::now() >= deadline) {
+                        expired.store(true, std::memory_order_relaxed);
+                        break;
+                    }
+                }
+
+                generateStressSequence(sequenceSeed(config.seed, index), config.max_ops,
+                                       config.max_length, ops);
+                run++;
+                ops_run += ops.size();
+                if (!runStressSequence<Driver>(ops.data(), ops.size(), buffers, mismatch)) {
+                    uint64_t seen = first_failure.load(std::memory_order_relaxed);
+                    while (index < seen && !first_failure.compare_exchange_weak(seen, index)) {
+                    }
+                    break;
+                }
+            }
+            sequences.fetch_add(run, std::memory_order_relaxed);
+            operations.fetch_add(ops_run, std::memory_order_relaxed);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (size_t t = 1; t < threads; t++) {
+        pool.push_back(std::thread(&Worker::run, std::cref(config), t, threads, std::ref(first_failure),
+                                   std::ref(sequences), std::ref(operations), std::ref(expired), deadline));
+    }
+    Worker::run(config, 0, threads, first_failure, sequences, operations, expired, deadline);
+    for (size_t t = 0; t < pool.size(); t++) {
+        pool[t].join();
+    }
+
+    StressResult result;
+    result.sequences = sequences.load();
+    result.operations = operations.load();
+    result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    result.threads = threads;
+    result.failed = first_failure.load() != no_failure;
+    result.failing_index = first_failure.load();
+    result.original_length = 0;
+    result.shrink_replays = 0;
+    result.mismatch.step = 0;
+    result.mismatch.what[0] = '\0';
+    if (result.failed) {
+        generateStressSequence(sequenceSeed(config.seed, result.failing_index), config.max_ops,
+                               config.max_length, result.failing_ops);
+        result.original_length = result.failing_ops.size();
+        result.shrink_replays = shrinkStressSequence<Driver>(result.failing_ops, result.mismatch);
+    }
+    return result;
+}
+
+} // namespace stress
+} // namespace uart
+
+#endif // UART_STRESS_H
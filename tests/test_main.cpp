@@ -9,6 +9,26 @@ extern int tests_failed;
 
 extern int runBasicTests();
 extern int runFifoTests();
+extern int runConcurrencyTests();
+extern int runBufferTests();
+extern int runInterruptTests();
+extern int runTimingTests();
+extern int runHubTests();
+extern int runDmaTests();
+extern int runParityTests();
+extern int runStatsTests();
+extern int runLinkTests();
+extern int runPtyTests();
+extern int runFramingTests();
+extern int runTraceTests();
+extern int runPortTableTests();
+extern int runMappedRegisterTests();
+extern int runShmTests();
+extern int runAsyncTests();
+extern int runFlowControlTests();
+extern int runReadLineTests();
+extern int runStressTests();
+extern int runTxSinkTests();
 
 } // namespace test
 } // namespace uart
@@ -20,6 +40,26 @@ int main() {
     // Run all test suites
     uart::test::runBasicTests();
     uart::test::runFifoTests();
+    uart::test::runConcurrencyTests();
+    uart::test::runBufferTests();
+    uart::test::runInterruptTests();
+    uart::test::runTimingTests();
+    uart::test::runHubTests();
+    uart::test::runDmaTests();
+    uart::test::runParityTests();
+    uart::test::runStatsTests();
+    uart::test::runLinkTests();
+    uart::test::runPtyTests();
+    uart::test::runFramingTests();
+    uart::test::runTraceTests();
+    uart::test::runPortTableTests();
+    uart::test::runMappedRegisterTests();
+    uart::test::runShmTests();
+    uart::test::runAsyncTests();
+    uart::test::runFlowControlTests();
+    uart::test::runReadLineTests();
+    uart::test::runStressTests();
+    uart::test::runTxSinkTests();
     
     // Print summary
     std::cout << "\n=======================================" << std::endl;
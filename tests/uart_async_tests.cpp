@@ -0,0 +1,229 @@
+#include "uart_async.h"
+#include <iostream>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace uart {
+namespace test {
+
+extern int tests_run;
+extern int tests_passed;
+extern int tests_failed;
+extern void reportTest(const char* name, bool passed);
+
+#define TEST(name, condition) \
+    reportTest(name, (condition))
+
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+
+static Task<void> readInto(AsyncUART& port, uint8_t* buffer, size_t length, size_t& result) {
+    result = co_await port.readAsync(buffer, length);
+}
+
+static Task<void> writeFrom(AsyncUART& port, const uint8_t* data, size_t length, size_t& result) {
+    result = co_await port.writeAsync(data, length);
+}
+
+static Task<void> readLine(AsyncUART& port, uint8_t* buffer, size_t max_length, size_t& result) {
+    result = co_await port.readUntil('\n', buffer, max_length);
+}
+
+void testAsyncReadWrite() {
+    std::cout << "\n=== Async Read/Write Tests ===" << std::endl;
+    
+    UARTDriver uart;
+    uart.initialize(115200);
+    UARTExecutor executor;
+    AsyncUART port(executor, uart);
+    
+    const size_t total = 4000;
+    std::vector<uint8_t> line(total);
+    std::vector<uint8_t> received(total);
+    std::vector<uint8_t> transmitted(total);
+    for (size_t i = 0; i < total; i++) {
+        line[i] = static_cast<uint8_t>(i * 13);
+    }
+    
+    size_t read_count = 0;
+    size_t write_count = 0;
+    executor.spawn(readInto(port, received.data(), total, read_count));
+    executor.spawn(writeFrom(port, line.data(), total, write_count));
+    
+    // Device side on its own thread: feed the line, transmit into a capture
+    std::thread device([&]() {
+        size_t fed = 0;
+        size_t sent = 0;
+        while (fed < total || sent < total) {
+            if (fed < total && uart.getRxSpace() > 0) {
+                size_t chunk = (total - fed < 7) ? total - fed : 7;
+                uart.simulateReceive(line.data() + fed, chunk);
+                fed += chunk;
+            }
+            sent += uart.drainTx(transmitted.data() + sent, total - sent);
+            std::this_thread::yield();
+        }
+    });
+    executor.run();
+    device.join();
+    
+    TEST("Read completes with every byte", read_count == total);
+    TEST("Read data intact", received == line);
+    TEST("Write queues every byte", write_count == total);
+    TEST("Transmitted data intact", transmitted == line);
+    TEST("No overruns", !uart.hasError());
+    TEST("No tasks left", executor.getLiveTasks() == 0);
+}
+
+void testAsyncManyPorts() {
+    std::cout << "\n=== Async Many Ports Tests ===" << std::endl;
+    
+    const size_t ports = 2000;
+    std::unique_ptr<UARTDriver[]> uarts(new UARTDriver[ports]);
+    std::vector<std::unique_ptr<AsyncUART> > async_ports;
+    UARTExecutor executor;
+    std::vector<size_t> results(ports, 0);
+    std::vector<uint8_t> lines(ports * 16, 0);
+    for (size_t i = 0; i < ports; i++) {
+        uarts[i].initialize(115200);
+        async_ports.push_back(std::unique_ptr<AsyncUART>(new AsyncUART(executor, uarts[i])));
+        executor.spawn(readLine(*async_ports[i], &lines[i * 16], 16, results[i]));
+    }
+    
+    executor.poll();
+    TEST("All readers parked on one thread", executor.getLiveTasks() == ports);
+    TEST("Idle poll resumes nothing", executor.poll() == 0);
+    
+    // Partial lines first: they stay queued and readers park again
+    const uint8_t head[] = {'a', 'b'};
+    const uint8_t tail[] = {'c', '\n', 'x'};
+    for (size_t i = 0; i < ports; i++) {
+        uarts[i].simulateReceive(head, sizeof(head));
+    }
+    executor.poll();
+    TEST("Partial lines keep readers waiting", executor.getLiveTasks() == ports &&
+                                               uarts[0].getRxFifoCount() == sizeof(head));
+    for (size_t i = 0; i < ports; i++) {
+        uarts[i].simulateReceive(tail, sizeof(tail));
+    }
+    executor.poll();
+    TEST("Every reader finished", executor.getLiveTasks() == 0);
+    
+    bool all_lines = true;
+    for (size_t i = 0; i < ports; i++) {
+        all_lines = all_lines && results[i] == 4 && memcmp(&lines[i * 16], "abc\n", 4) == 0;
+    }
+    TEST("Each reader got its whole line", all_lines);
+    TEST("Bytes after the delimiter left in the FIFO", uarts[0].getRxFifoCount() == 1);
+}
+
+void testAsyncReadUntil() {
+    std::cout << "\n=== Async readUntil Tests ===" << std::endl;
+    
+    UARTDriver uart;
+    uart.initialize(115200);
+    UARTExecutor executor;
+    AsyncUART port(executor, uart);
+    
+    // Move the ring indices so the line wraps
+    uint8_t filler[12] = {0};
+    uint8_t scratch[12];
+    uart.simulateReceive(filler, sizeof(filler));
+    uart.readData(scratch, sizeof(scratch));
+    uart.simulateReceive(reinterpret_cast<const uint8_t*>("wrapped ln\nrest"), 15);
+    
+    uint8_t buffer[32];
+    size_t result = 0;
+    executor.spawn(readLine(port, buffer, sizeof(buffer), result));
+    executor.poll();
+    TEST("Line read across the ring wrap", result == 11 && memcmp(buffer, "wrapped ln\n", 11) == 0);
+    
+    executor.spawn(readLine(port, buffer, 3, result));
+    executor.poll();
+    TEST("Max length ends the read", result == 3 && memcmp(buffer, "res", 3) == 0);
+    
+    executor.spawn(readLine(port, buffer, sizeof(buffer), result));
+    executor.poll();
+    TEST("Unterminated data waits", executor.getLiveTasks() == 1);
+    uart.simulateReceive(reinterpret_cast<const uint8_t*>("ai"), 2);
+    executor.poll();
+    TEST("Partial record stays queued", executor.getLiveTasks() == 1 && uart.getRxFifoCount() == 3);
+    uart.simulateReceive(reinterpret_cast<const uint8_t*>("l\n"), 2);
+    executor.poll();
+    TEST("Record read once complete", executor.getLiveTasks() == 0 && result == 5 && memcmp(buffer, "tail\n", 5) == 0);
+    
+    // A record longer than the FIFO is taken in as it arrives
+    uint8_t longer[40];
+    memset(longer, 'z', sizeof(longer));
+    executor.spawn(readLine(port, longer, sizeof(longer), result));
+    executor.poll();
+    uint8_t run[FIFO_DEPTH];
+    memset(run, 'y', sizeof(run));
+    uart.simulateReceive(run, sizeof(run));
+    executor.poll();
+    uart.simulateReceive(run, 4);
+    executor.poll();
+    TEST("Record filling the FIFO keeps the line flowing", executor.getLiveTasks() == 1 &&
+                                                         uart.getRxFifoCount() == 4 && !uart.hasError());
+    uart.simulateReceive(reinterpret_cast<const uint8_t*>("\n"), 1);
+    executor.poll();
+    TEST("Overlong record assembled in order", executor.getLiveTasks() == 0 && result == FIFO_DEPTH + 5 &&
+                                               longer[FIFO_DEPTH + 3] == 'y' && longer[FIFO_DEPTH + 4] == '\n');
+    
+    executor.spawn(readLine(port, buffer, sizeof(buffer), result));
+    uart.simulateReceive(reinterpret_cast<const uint8_t*>("no"), 2);
+    executor.poll();
+    port.close();
+    executor.poll();
+    TEST("close() ends the wait, record left queued", executor.getLiveTasks() == 0 && result == 0 &&
+                                                      uart.getRxFifoCount() == 2);
+    
+    size_t write_result = 99;
+    executor.spawn(writeFrom(port, filler, sizeof(filler), write_result));
+    executor.poll();
+    TEST("Closed port still moves what fits", write_result == sizeof(filler));
+}
+
+void testAsyncPortDestroyed() {
+    std::cout << "\n=== Async Port Lifetime Tests ===" << std::endl;
+    
+    UARTDriver uart;
+    uart.initialize(115200);
+    UARTExecutor executor;
+    std::unique_ptr<AsyncUART> port(new AsyncUART(executor, uart));
+    
+    // Signal the port, then destroy it before the executor collects it
+    uint8_t data[2] = {1, 2};
+    uart.simulateReceive(data, sizeof(data));
+    port.reset();
+    TEST("Destroyed port's signal withdrawn", executor.poll() == 0);
+    
+    size_t result = 0;
+    uint8_t buffer[2];
+    AsyncUART again(executor, uart);
+    executor.spawn(readInto(again, buffer, sizeof(buffer), result));
+    executor.poll();
+    TEST("Executor still serves other ports", executor.getLiveTasks() == 0 && result == 2);
+}
+
+#endif
+
+int runAsyncTests() {
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "Running Async Tests" << std::endl;
+    std::cout << "========================================" << std::endl;
+    
+    testAsyncReadWrite();
+    testAsyncManyPorts();
+    testAsyncReadUntil();
+    testAsyncPortDestroyed();
+#endif
+    
+    return tests_failed;
+}
+
+} // namespace test
+} // namespace uart
@@ -124,6 +124,37 @@ void testShutdown() {
     TEST("Cannot write after shutdown", !uart.writeByte(0x55));
 }
 
+void testStatusRegister() {
+    std::cout << "\n=== Status Register Tests ===" << std::endl;
+    
+    UARTDriver uart;
+    uart.initialize(115200);
+    TEST("Status shows both FIFOs empty", uart.readStatus() == (STATUS_TX_EMPTY | STATUS_RX_EMPTY));
+    
+    uint8_t data[FIFO_DEPTH] = {0};
+    uart.writeData(data, FIFO_DEPTH);
+    uart.simulateReceive(data, 1);
+    uint32_t status = uart.readStatus();
+    TEST("Status shows TX full", (status & STATUS_TX_FULL) != 0);
+    TEST("Status clears TX empty", (status & STATUS_TX_EMPTY) == 0);
+    TEST("Status clears RX empty", (status & STATUS_RX_EMPTY) == 0);
+    TEST("Status RX not full", (status & STATUS_RX_FULL) == 0);
+    
+    uart.simulateReceive(data, FIFO_DEPTH);
+    status = uart.readStatus();
+    TEST("Status shows RX full", (status & STATUS_RX_FULL) != 0);
+    TEST("Status shows overrun", (status & STATUS_OVERRUN) != 0);
+    
+    uart.simulateTransmit(FIFO_DEPTH);
+    uart.readData(data, FIFO_DEPTH);
+    status = uart.readStatus();
+    TEST("Overrun is sticky after drain", (status & STATUS_OVERRUN) != 0);
+    TEST("FIFO bits follow drain", (status & STATUS_FIFO_MASK) == (STATUS_TX_EMPTY | STATUS_RX_EMPTY));
+    
+    uart.clearErrors();
+    TEST("W1C clears overrun", (uart.readStatus() & STATUS_ERROR_MASK) == 0);
+}
+
 int runBasicTests() {
     std::cout << "\n========================================" << std::endl;
     std::cout << "Running Basic UART Driver Tests" << std::endl;
@@ -135,6 +166,7 @@ int runBasicTests() {
     testMultiByteOperations();
     testParityConfiguration();
     testShutdown();
+    testStatusRegister();
     
     return tests_failed;
 }
@@ -0,0 +1,115 @@
+#include "uart_driver.h"
+#include <iostream>
+#include <cstring>
+#include <vector>
+
+namespace uart {
+namespace test {
+
+extern int tests_run;
+extern int tests_passed;
+extern int tests_failed;
+extern void reportTest(const char* name, bool passed);
+
+#define TEST(name, condition) \
+    reportTest(name, (condition))
+
+void testRxBurstSurvives() {
+    std::cout << "\n=== Software RX Buffer Tests ===" << std::endl;
+    
+    UARTDriver uart;
+    uart.initialize(115200);
+    TEST("Attach default software buffers", uart.attachSoftwareBuffers(SoftwareBufferConfig()));
+    
+    std::vector<uint8_t> burst(10000);
+    for (size_t i = 0; i < burst.size(); i++) {
+        burst[i] = static_cast<uint8_t>(i * 13);
+    }
+    uart.simulateReceive(burst.data(), burst.size());
+    
+    TEST("Burst larger than FIFO does not overrun", !uart.hasError());
+    TEST("Burst lands in software buffer", uart.getRxBufferCount() == burst.size());
+    TEST("Hardware FIFO drained after burst", uart.getRxFifoCount() == 0);
+    TEST("Has data from software buffer", uart.hasData());
+    
+    std::vector<uint8_t> out(burst.size());
+    size_t read = uart.readData(out.data(), out.size());
+    TEST("Read whole burst in one call", read == burst.size());
+    TEST("Burst data intact", out == burst);
+}
+
+void testRxBufferOverrun() {
+    std::cout << "\n=== Software RX Buffer Overrun Tests ===" << std::endl;
+    
+    UARTDriver uart;
+    uart.initialize(115200);
+    
+    SoftwareBufferConfig config;
+    config.rx_capacity = 64;
+    config.rx_high_watermark = 8;
+    uart.attachSoftwareBuffers(config);
+    
+    uint8_t burst[128] = {0};
+    uart.simulateReceive(burst, sizeof(burst));
+    TEST("Overrun once both tiers are full", uart.hasError());
+    TEST("Software buffer full", uart.getRxBufferCount() == 64);
+    TEST("Hardware FIFO holds the rest", uart.getRxFifoCount() == FIFO_DEPTH);
+    
+    uint8_t out[128];
+    TEST("Drain software buffer", uart.readData(out, sizeof(out)) == 64);
+    uart.serviceSoftwareBuffers();
+    TEST("Service moves waiting FIFO bytes", uart.getRxBufferCount() == FIFO_DEPTH);
+}
+
+void testTxRefill() {
+    std::cout << "\n=== Software TX Buffer Tests ===" << std::endl;
+    
+    // Arena-backed storage
+    static uint8_t tx_arena[4096];
+    static uint8_t rx_arena[4096];
+    
+    UARTDriver uart;
+    uart.initialize(115200);
+    
+    SoftwareBufferConfig bad;
+    bad.tx_memory = tx_arena;
+    bad.tx_capacity = 3000;
+    TEST("Reject non power-of-two arena", !uart.attachSoftwareBuffers(bad));
+    
+    SoftwareBufferConfig config;
+    config.tx_memory = tx_arena;
+    config.tx_capacity = sizeof(tx_arena);
+    config.rx_memory = rx_arena;
+    config.rx_capacity = sizeof(rx_arena);
+    TEST("Attach arena-backed buffers", uart.attachSoftwareBuffers(config));
+    
+    uint8_t message[3000];
+    memset(message, 0x33, sizeof(message));
+    TEST("Write large chunk", uart.writeData(message, sizeof(message)) == sizeof(message));
+    TEST("Can still transmit", uart.canTransmit());
+    
+    uart.simulateTransmit(1000);
+    TEST("Partial transmit leaves remainder", uart.getTxBufferCount() + uart.getTxFifoCount() == 2000);
+    TEST("TX FIFO refilled above low watermark", uart.getTxFifoCount() > FIFO_DEPTH / 4);
+    
+    uart.simulateTransmit(5000);
+    TEST("Everything transmitted", uart.getTxBufferCount() == 0 && uart.getTxFifoCount() == 0);
+    
+    uart.detachSoftwareBuffers();
+    TEST("Detached driver limited to FIFO", uart.writeData(message, sizeof(message)) == FIFO_DEPTH);
+}
+
+int runBufferTests() {
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "Running Software Buffer Tests" << std::endl;
+    std::cout << "========================================" << std::endl;
+    
+    testRxBurstSurvives();
+    testRxBufferOverrun();
+    testTxRefill();
+    
+    return tests_failed;
+}
+
+} // namespace test
+} // namespace uart
@@ -0,0 +1,153 @@
+#include "uart_driver.h"
+#include <iostream>
+#include <cstring>
+#include <thread>
+
+namespace uart {
+namespace test {
+
+extern int tests_run;
+extern int tests_passed;
+extern int tests_failed;
+extern void reportTest(const char* name, bool passed);
+
+#define TEST(name, condition) \
+    reportTest(name, (condition))
+
+static const size_t STREAM_LENGTH = 200000;
+
+static uint8_t streamByte(size_t i) {
+    return static_cast<uint8_t>((i * 7) ^ (i >> 8));
+}
+
+void testSpscRingBasics() {
+    std::cout << "\n=== SPSC Ring Tests ===" << std::endl;
+    
+    SPSCRing<8> ring;
+    uint8_t data[12] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+    
+    TEST("Ring starts empty", ring.empty() && ring.count() == 0);
+    TEST("Ring accepts up to capacity", ring.write(data, 12) == 8);
+    TEST("Ring reports full", ring.full() && ring.freeSpace() == 0);
+    TEST("Push to full ring fails", !ring.push(0xFF));
+    
+    uint8_t out[8];
+    TEST("Partial read", ring.read(out, 5) == 5 && out[4] == 5);
+    TEST("Write across wrap", ring.write(data + 8, 4) == 4);
+    TEST("Read across wrap", ring.read(out, 8) == 7 && out[0] == 6 && out[6] == 12);
+    TEST("Ring empty after drain", ring.empty() && ring.available() == 0);
+    
+    SPSCRing<8>* heap_ring = new SPSCRing<8>;
+    TEST("Heap ring is cache-line aligned",
+         reinterpret_cast<uintptr_t>(heap_ring) % CACHE_LINE_SIZE == 0);
+    delete heap_ring;
+    UARTDriver* drivers = new UARTDriver[3];
+    TEST("Driver array elements are cache-line aligned",
+         reinterpret_cast<uintptr_t>(&drivers[1]) % CACHE_LINE_SIZE == 0 &&
+         sizeof(UARTDriver) % CACHE_LINE_SIZE == 0);
+    delete[] drivers;
+}
+
+void testConcurrentReceiveStream() {
+    std::cout << "\n=== Concurrent RX Stream Tests ===" << std::endl;
+    
+    UARTDriver uart;
+    uart.initialize(115200);
+    
+    // Device thread: feed the RX FIFO without ever overrunning it
+    std::thread device([&uart]() {
+        uint8_t chunk[FIFO_DEPTH];
+        size_t sent = 0;
+        while (sent < STREAM_LENGTH) {
+            size_t space = FIFO_DEPTH - uart.getRxFifoCount();
+            size_t n = STREAM_LENGTH - sent;
+            if (n > space) {
+                n = space;
+            }
+            for (size_t i = 0; i < n; i++) {
+                chunk[i] = streamByte(sent + i);
+            }
+            uart.simulateReceive(chunk, n);
+            sent += n;
+            if (n == 0) {
+                std::this_thread::yield();
+            }
+        }
+    });
+    
+    // Application thread: read the stream back and check ordering
+    bool intact = true;
+    size_t received = 0;
+    uint8_t buffer[FIFO_DEPTH];
+    while (received < STREAM_LENGTH) {
+        size_t n = uart.readData(buffer, sizeof(buffer));
+        for (size_t i = 0; i < n; i++) {
+            if (buffer[i] != streamByte(received + i)) {
+                intact = false;
+            }
+        }
+        received += n;
+        if (n == 0) {
+            std::this_thread::yield();
+        }
+    }
+    device.join();
+    
+    TEST("Concurrent RX stream complete", received == STREAM_LENGTH);
+    TEST("Concurrent RX stream in order", intact);
+    TEST("No overrun in concurrent RX stream", !uart.hasError());
+}
+
+void testConcurrentTransmitDrain() {
+    std::cout << "\n=== Concurrent TX Drain Tests ===" << std::endl;
+    
+    UARTDriver uart;
+    uart.initialize(115200);
+    
+    // Device thread: drain whatever the application queues
+    std::thread device([&uart]() {
+        size_t drained = 0;
+        while (drained < STREAM_LENGTH) {
+            size_t n = uart.getTxFifoCount();
+            uart.simulateTransmit(n);
+            drained += n;
+            if (n == 0) {
+                std::this_thread::yield();
+            }
+        }
+    });
+    
+    size_t queued = 0;
+    uint8_t chunk[FIFO_DEPTH];
+    memset(chunk, 0x5A, sizeof(chunk));
+    while (queued < STREAM_LENGTH) {
+        size_t n = STREAM_LENGTH - queued;
+        if (n > sizeof(chunk)) {
+            n = sizeof(chunk);
+        }
+        size_t written = uart.writeData(chunk, n);
+        queued += written;
+        if (written == 0) {
+            std::this_thread::yield();
+        }
+    }
+    device.join();
+    
+    TEST("Concurrent TX stream fully queued", queued == STREAM_LENGTH);
+    TEST("TX FIFO empty after concurrent drain", uart.getTxFifoCount() == 0);
+}
+
+int runConcurrencyTests() {
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "Running Concurrency Tests" << std::endl;
+    std::cout << "========================================" << std::endl;
+    
+    testSpscRingBasics();
+    testConcurrentReceiveStream();
+    testConcurrentTransmitDrain();
+    
+    return tests_failed;
+}
+
+} // namespace test
+} // namespace uart
@@ -0,0 +1,178 @@
+#include "uart_dma.h"
+#include <iostream>
+#include <cstring>
+#include <vector>
+
+namespace uart {
+namespace test {
+
+extern int tests_run;
+extern int tests_passed;
+extern int tests_failed;
+extern void reportTest(const char* name, bool passed);
+
+#define TEST(name, condition) \
+    reportTest(name, (condition))
+
+struct DmaLog {
+    std::vector<uint32_t> tx_events;
+    std::vector<uint32_t> rx_events;
+};
+
+static void recordDma(DmaChannelId channel, uint32_t events, void* context) {
+    DmaLog* log = static_cast<DmaLog*>(context);
+    if (channel == DMA_CHANNEL_TX) {
+        log->tx_events.push_back(events);
+    } else {
+        log->rx_events.push_back(events);
+    }
+}
+
+static DmaDescriptor makeDescriptor(uint8_t* buffer, size_t length, DmaDescriptor* next) {
+    DmaDescriptor desc = {buffer, length, next, 0, false};
+    return desc;
+}
+
+void testDmaTransmitChain() {
+    std::cout << "\n=== DMA TX Chain Tests ===" << std::endl;
+    
+    UARTDriver uart;
+    uart.initialize(115200);
+    UARTDma dma(uart);
+    DmaLog log;
+    dma.setCallback(&recordDma, &log);
+    
+    uint8_t a[100], b[50], c[200];
+    memset(a, 1, sizeof(a));
+    memset(b, 2, sizeof(b));
+    memset(c, 3, sizeof(c));
+    DmaDescriptor d3 = makeDescriptor(c, sizeof(c), nullptr);
+    DmaDescriptor d2 = makeDescriptor(b, sizeof(b), &d3);
+    DmaDescriptor d1 = makeDescriptor(a, sizeof(a), &d2);
+    
+    TEST("Start TX chain", dma.startTx(&d1));
+    TEST("Busy channel rejects second chain", !dma.startTx(&d1));
+    TEST("Start primes the TX FIFO", uart.getTxFifoCount() == FIFO_DEPTH);
+    
+    uart.simulateTransmit(1000);
+    TEST("Whole chain transmitted", dma.getStats(DMA_CHANNEL_TX).bytes == 350);
+    TEST("TX FIFO empty", uart.getTxFifoCount() == 0);
+    TEST("Channel idle after chain", !dma.isBusy(DMA_CHANNEL_TX));
+    TEST("All descriptors done", d1.done && d2.done && d3.done);
+    TEST("Complete status latched", (dma.getStatus(DMA_CHANNEL_TX) & DMA_EVENT_COMPLETE) != 0);
+    
+    int descriptors = 0;
+    bool half_before_complete = false;
+    bool seen_half = false;
+    for (size_t i = 0; i < log.tx_events.size(); i++) {
+        if (log.tx_events[i] & DMA_EVENT_DESCRIPTOR) {
+            descriptors++;
+        }
+        if (log.tx_events[i] & DMA_EVENT_HALF) {
+            seen_half = true;
+        }
+        if (log.tx_events[i] & DMA_EVENT_COMPLETE) {
+            half_before_complete = seen_half;
+        }
+    }
+    TEST("One event per descriptor", descriptors == 3);
+    TEST("Half-transfer before completion", half_before_complete);
+}
+
+void testDmaReceiveChain() {
+    std::cout << "\n=== DMA RX Chain Tests ===" << std::endl;
+    
+    UARTDriver uart;
+    uart.initialize(115200);
+    UARTDma dma(uart);
+    
+    uint8_t first[64], second[64];
+    DmaDescriptor d2 = makeDescriptor(second, sizeof(second), nullptr);
+    DmaDescriptor d1 = makeDescriptor(first, sizeof(first), &d2);
+    TEST("Start RX chain", dma.startRx(&d1));
+    
+    uint8_t burst[128];
+    for (int i = 0; i < 128; i++) {
+        burst[i] = static_cast<uint8_t>(i);
+    }
+    uart.simulateReceive(burst, 100);
+    TEST("Burst larger than FIFO does not overrun", !uart.hasError());
+    TEST("First descriptor filled", d1.done && memcmp(first, burst, 64) == 0);
+    TEST("Second descriptor partial", !d2.done && d2.transferred == 36);
+    TEST("Half-transfer latched", dma.getStatus(DMA_CHANNEL_RX) == (DMA_EVENT_DESCRIPTOR | DMA_EVENT_HALF));
+    
+    uart.simulateReceive(burst + 100, 28);
+    TEST("Chain complete", !dma.isBusy(DMA_CHANNEL_RX) && d2.done);
+    TEST("Second descriptor data", memcmp(second, burst + 64, 64) == 0);
+    TEST("No application reads needed", uart.getRxFifoCount() == 0);
+}
+
+void testDmaCircular() {
+    std::cout << "\n=== DMA Circular Mode Tests ===" << std::endl;
+    
+    UARTDriver uart;
+    uart.initialize(115200);
+    UARTDma dma(uart);
+    DmaLog log;
+    dma.setCallback(&recordDma, &log);
+    
+    uint8_t half_a[16], half_b[16];
+    DmaDescriptor d2 = makeDescriptor(half_b, sizeof(half_b), nullptr);
+    DmaDescriptor d1 = makeDescriptor(half_a, sizeof(half_a), &d2);
+    d2.next = &d1;
+    dma.startRx(&d1);
+    
+    uint8_t burst[80];
+    for (int i = 0; i < 80; i++) {
+        burst[i] = static_cast<uint8_t>(i);
+    }
+    uart.simulateReceive(burst, sizeof(burst));
+    
+    TEST("Circular channel stays busy", dma.isBusy(DMA_CHANNEL_RX));
+    TEST("Two passes completed", dma.getStats(DMA_CHANNEL_RX).chains == 2);
+    TEST("Third pass half done", dma.getTransferred(DMA_CHANNEL_RX) == 16);
+    TEST("Latest data in first half", memcmp(half_a, burst + 64, 16) == 0);
+    TEST("No overrun in circular mode", !uart.hasError());
+}
+
+void testDmaMalformedChain() {
+    std::cout << "\n=== DMA Malformed Chain Tests ===" << std::endl;
+    
+    UARTDriver uart;
+    uart.initialize(115200);
+    UARTDma dma(uart);
+    
+    // A -> B -> C -> B never returns to A
+    uint8_t a[4], b[4], c[4];
+    DmaDescriptor dc = makeDescriptor(c, sizeof(c), nullptr);
+    DmaDescriptor db = makeDescriptor(b, sizeof(b), &dc);
+    DmaDescriptor da = makeDescriptor(a, sizeof(a), &db);
+    dc.next = &db;
+    TEST("Loop into the middle rejected for TX", !dma.startTx(&da));
+    TEST("Loop into the middle rejected for RX", !dma.startRx(&da));
+    TEST("Rejected chain leaves channels idle", !dma.isBusy(DMA_CHANNEL_TX) && !dma.isBusy(DMA_CHANNEL_RX));
+    
+    DmaDescriptor self = makeDescriptor(a, sizeof(a), nullptr);
+    self.next = &self;
+    TEST("Self loop is circular mode", dma.startRx(&self) && dma.isBusy(DMA_CHANNEL_RX));
+    dma.abort(DMA_CHANNEL_RX);
+    
+    db.next = &da;
+    TEST("Loop back to the head accepted", dma.startRx(&db));
+}
+
+int runDmaTests() {
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "Running DMA Tests" << std::endl;
+    std::cout << "========================================" << std::endl;
+    
+    testDmaTransmitChain();
+    testDmaReceiveChain();
+    testDmaCircular();
+    testDmaMalformedChain();
+    
+    return tests_failed;
+}
+
+} // namespace test
+} // namespace uart
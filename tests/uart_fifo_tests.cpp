@@ -190,6 +190,116 @@ void testSequentialFill() {
     TEST("Wrote exactly 16 bytes again", bytes_written == 16);
 }
 
+void testBulkWrapAroundData() {
+    std::cout << "\n=== Bulk Wrap-Around Data Tests ===" << std::endl;
+    
+    UARTDriver uart;
+    uart.initialize(115200);
+    
+    // Move the RX ring position near the end so the next burst wraps
+    uint8_t filler[12] = {0};
+    uart.simulateReceive(filler, 12);
+    uint8_t sink[16];
+    TEST("Drain filler bytes", uart.readData(sink, 12) == 12);
+    
+    uint8_t rx_data[16];
+    for (int i = 0; i < 16; i++) {
+        rx_data[i] = 0x40 + i;
+    }
+    uart.simulateReceive(rx_data, 16);
+    TEST("Wrapped burst fills RX FIFO", uart.getRxFifoCount() == 16);
+    TEST("No overrun on exact fill", !uart.hasError());
+    
+    uint8_t buffer[16];
+    size_t read = uart.readData(buffer, 16);
+    TEST("Read wrapped burst", read == 16);
+    TEST("Wrapped burst data intact", memcmp(buffer, rx_data, 16) == 0);
+    
+    // Same for the TX ring: bulk write across the wrap point is truncated to free space
+    uart.writeData(filler, 10);
+    uart.simulateTransmit(10);
+    size_t written = uart.writeData(rx_data, 16);
+    TEST("Bulk write across wrap fills TX FIFO", written == 16);
+    TEST("Bulk write to full TX FIFO returns 0", uart.writeData(rx_data, 1) == 0);
+}
+
+void testConfigurableDepth() {
+    std::cout << "\n=== Configurable FIFO Depth Tests ===" << std::endl;
+    
+    BasicUARTDriver<64, 128> uart;
+    uart.initialize(115200);
+    
+    uint8_t data[256];
+    for (int i = 0; i < 256; i++) {
+        data[i] = static_cast<uint8_t>(i);
+    }
+    
+    TEST("64-entry TX FIFO accepts 64 bytes", uart.writeData(data, 256) == 64);
+    TEST("64-entry TX FIFO is full", !uart.canTransmit());
+    
+    uart.simulateReceive(data, 128);
+    TEST("128-entry RX FIFO holds 128 bytes", uart.getRxFifoCount() == 128);
+    TEST("No overrun at 128 bytes", !uart.hasError());
+    uart.simulateReceive(data, 1);
+    TEST("Overrun past 128 bytes", uart.hasError());
+    
+    BasicUARTDriver<4096, 4096> big;
+    big.initialize(115200);
+    TEST("4096-entry TX FIFO accepts full burst", big.writeData(data, 256) == 256);
+    TEST("Depth constants exposed", (BasicUARTDriver<4096, 4096>::TX_FIFO_DEPTH == 4096));
+}
+
+void testZeroCopyRegions() {
+    std::cout << "\n=== Zero-Copy Region Tests ===" << std::endl;
+    
+    UARTDriver uart;
+    uart.initialize(115200);
+    
+    // Move the RX ring position so the next burst wraps
+    uint8_t filler[10] = {0};
+    uart.simulateReceive(filler, 10);
+    uart.consumeRx(10);
+    
+    uint8_t rx_data[12];
+    for (int i = 0; i < 12; i++) {
+        rx_data[i] = 0x60 + i;
+    }
+    uart.simulateReceive(rx_data, 12);
+    
+    ConstByteRegions rx = uart.peekRx();
+    TEST("Peek exposes all received bytes", rx.size() == 12);
+    TEST("Peek splits at the wrap", rx.first.size == 6 && rx.second.size == 6);
+    TEST("Peek regions hold the data in order",
+         memcmp(rx.first.data, rx_data, 6) == 0 && memcmp(rx.second.data, rx_data + 6, 6) == 0);
+    TEST("Peek does not consume", uart.getRxFifoCount() == 12);
+    TEST("Consume releases bytes", uart.consumeRx(5) == 5 && uart.getRxFifoCount() == 7);
+    TEST("Consume clamps to available", uart.consumeRx(100) == 7 && !uart.hasData());
+    
+    // TX: reserve across the wrap, fill in place, then commit
+    uart.writeData(filler, 10);
+    uart.simulateTransmit(10);
+    ByteRegions tx = uart.reserveTx(100);
+    TEST("Reserve limited to free space", tx.size() == FIFO_DEPTH);
+    TEST("Reserve splits at the wrap", tx.first.size == 6 && tx.second.size == 10);
+    TEST("Reserved bytes not yet queued", uart.getTxFifoCount() == 0);
+    
+    memset(tx.first.data, 0xAB, tx.first.size);
+    memset(tx.second.data, 0xCD, 2);
+    uart.commitTx(tx.first.size + 2);
+    TEST("Commit queues written bytes", uart.getTxFifoCount() == 8);
+    TEST("Reserve after commit sees remaining space", uart.reserveTx(100).size() == 8);
+    
+    // Over-commit is clamped to the free space instead of passing the consumer
+    PortStats before = uart.getStats();
+    TEST("Empty commit queues nothing", uart.commitTx(0) == 0);
+    TEST("Empty commit not counted", uart.getStats().tx_full_rejects == before.tx_full_rejects);
+    TEST("Over-commit clamped", uart.commitTx(100) == 8 && uart.getTxFifoCount() == FIFO_DEPTH);
+    TEST("Over-commit counted as a rejected write",
+         uart.getStats().tx_full_rejects == before.tx_full_rejects + 1);
+    uart.simulateTransmit(FIFO_DEPTH);
+    TEST("FIFO count intact after over-commit", uart.getTxFifoCount() == 0);
+}
+
 int runFifoTests() {
     std::cout << "\n========================================" << std::endl;
     std::cout << "Running FIFO Boundary Tests" << std::endl;
@@ -202,6 +312,9 @@ int runFifoTests() {
     testAlternatingReadWrite();
     testBoundaryConditions();
     testSequentialFill();
+    testBulkWrapAroundData();
+    testConfigurableDepth();
+    testZeroCopyRegions();
     
     return tests_failed;
 }
@@ -0,0 +1,164 @@
+#include "uart_driver.h"
+#include "uart_link.h"
+#include <iostream>
+#include <cstring>
+#include <vector>
+
+namespace uart {
+namespace test {
+
+extern int tests_run;
+extern int tests_passed;
+extern int tests_failed;
+extern void reportTest(const char* name, bool passed);
+
+#define TEST(name, condition) \
+    reportTest(name, (condition))
+
+void testHardwareFlowControl() {
+    std::cout << "\n=== RTS/CTS Flow Control Tests ===" << std::endl;
+    
+    UARTDriver uart;
+    uart.initialize(115200);
+    TEST("Bad thresholds rejected", !uart.configureFlowControl(CTRL_RTSCTS, 8, 8));
+    TEST("Unknown mode rejected", !uart.configureFlowControl(CTRL_PARITY_EN));
+    TEST("RTS/CTS enabled", uart.configureFlowControl(CTRL_RTSCTS, 10, 4));
+    TEST("Mode visible in control register", (uart.readControl() & CTRL_FLOW_MASK) == CTRL_RTSCTS);
+    TEST("CTS asserted when enabled", (uart.readStatus() & STATUS_CTS) != 0);
+    
+    uint8_t data[16];
+    for (int i = 0; i < 16; i++) {
+        data[i] = static_cast<uint8_t>(0x40 + i);
+    }
+    uart.simulateReceive(data, 9);
+    TEST("RTS asserted below the stop level", uart.isRtsAsserted());
+    uart.simulateReceive(data, 1);
+    TEST("RTS drops at the stop level", !uart.isRtsAsserted());
+    
+    uint8_t buffer[16];
+    uart.readData(buffer, 5);
+    TEST("RTS stays low above the resume level", !uart.isRtsAsserted());
+    uart.readData(buffer, 1);
+    TEST("RTS returns at the resume level", uart.isRtsAsserted());
+    
+    uart.writeData(data, 6);
+    uart.setCts(false);
+    TEST("Status shows CTS low", (uart.readStatus() & STATUS_CTS) == 0);
+    TEST("Transmitter paused by CTS", uart.isTxPaused() && uart.drainTx(buffer, 16) == 0);
+    TEST("Paused data stays queued", uart.getTxFifoCount() == 6);
+    uart.setCts(true);
+    TEST("Transmit resumes with CTS", uart.drainTx(buffer, 16) == 6 && buffer[5] == 0x45);
+}
+
+void testSoftwareFlowControl() {
+    std::cout << "\n=== XON/XOFF Flow Control Tests ===" << std::endl;
+    
+    UARTDriver uart;
+    uart.initialize(115200);
+    TEST("XON/XOFF enabled with defaults", uart.configureFlowControl(CTRL_XONXOFF));
+    
+    uint8_t data[16];
+    for (int i = 0; i < 16; i++) {
+        data[i] = static_cast<uint8_t>(0x40 + i);
+    }
+    uart.writeData(data, 4);
+    uart.simulateReceive(data, 12);
+    
+    uint8_t out[16];
+    size_t sent = uart.drainTx(out, 16);
+    TEST("XOFF sent ahead of data at three quarters full", sent == 5 && out[0] == XOFF_CHAR && out[1] == 0x40);
+    TEST("XOFF counted as line traffic", uart.getStats().tx_bytes == 5);
+    
+    uint8_t buffer[16];
+    uart.readData(buffer, 8);
+    TEST("XON queued at one quarter full", uart.drainTx(out, 16) == 1 && out[0] == XON_CHAR);
+    TEST("Nothing more to announce", uart.drainTx(out, 16) == 0);
+    
+    // Peer pauses us mid-stream; control characters are not delivered
+    const uint8_t incoming[] = {'a', XOFF_CHAR, 'b', 'c'};
+    uart.readData(buffer, sizeof(buffer));
+    uart.simulateReceive(incoming, sizeof(incoming));
+    TEST("Control characters filtered from RX", uart.readData(buffer, sizeof(buffer)) == 3 &&
+                                                memcmp(buffer, "abc", 3) == 0);
+    TEST("XOFF pauses the transmitter", uart.isTxPaused());
+    uart.writeData(data, 3);
+    TEST("Paused transmitter sends nothing", uart.drainTx(out, 16) == 0);
+    const uint8_t xon = XON_CHAR;
+    uart.simulateReceive(&xon, 1);
+    TEST("XON resumes the transmitter", !uart.isTxPaused() && uart.drainTx(out, 16) == 3);
+    
+    uart.configureFlowControl(0);
+    uart.simulateReceive(incoming, sizeof(incoming));
+    TEST("Control characters delivered with flow control off", uart.getRxFifoCount() == 4);
+}
+
+// Sender streams to a slow reader over the link; returns bytes the reader lost
+static uint64_t streamToSlowReader(uint32_t mode, size_t step, std::vector<uint8_t>& received) {
+    UARTDriver sender;
+    UARTDriver reader;
+    sender.initialize(115200);
+    reader.initialize(115200);
+    sender.configureFlowControl(mode);
+    reader.configureFlowControl(mode);
+    UARTLink link(sender, reader);
+    
+    const size_t total = 3000;
+    size_t queued = 0;
+    uint8_t chunk[16];
+    for (int round = 0; round < 100000 && received.size() < total; round++) {
+        while (queued < total && sender.canTransmit()) {
+            sender.writeByte(static_cast<uint8_t>(0x20 + queued % 0x50));
+            queued++;
+        }
+        link.transfer(UARTLink::A_TO_B, step);
+        link.transfer(UARTLink::B_TO_A, step);
+        if (round % 4 == 0) {
+            size_t n = reader.readData(chunk, 3);
+            received.insert(received.end(), chunk, chunk + n);
+        }
+        if (queued == total && sender.getTxFifoCount() == 0 && reader.getRxFifoCount() == 0 &&
+            received.size() < total && mode == 0) {
+            break;  // Free-running line: lost bytes never arrive
+        }
+    }
+    return reader.getStats().rx_dropped_bytes;
+}
+
+static bool inOrder(const std::vector<uint8_t>& received) {
+    for (size_t i = 0; i < received.size(); i++) {
+        if (received[i] != static_cast<uint8_t>(0x20 + i % 0x50)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void testFlowControlOverLink() {
+    std::cout << "\n=== Flow Control Over Link Tests ===" << std::endl;
+    
+    std::vector<uint8_t> free_running;
+    TEST("Without flow control the slow reader overruns", streamToSlowReader(0, 8, free_running) > 0);
+    
+    std::vector<uint8_t> hardware;
+    TEST("RTS/CTS: no drops", streamToSlowReader(CTRL_RTSCTS, 8, hardware) == 0);
+    TEST("RTS/CTS: every byte in order", hardware.size() == 3000 && inOrder(hardware));
+    
+    std::vector<uint8_t> software;
+    TEST("XON/XOFF: no drops", streamToSlowReader(CTRL_XONXOFF, 1, software) == 0);
+    TEST("XON/XOFF: every byte in order", software.size() == 3000 && inOrder(software));
+}
+
+int runFlowControlTests() {
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "Running Flow Control Tests" << std::endl;
+    std::cout << "========================================" << std::endl;
+    
+    testHardwareFlowControl();
+    testSoftwareFlowControl();
+    testFlowControlOverLink();
+    
+    return tests_failed;
+}
+
+} // namespace test
+} // namespace uart
@@ -0,0 +1,201 @@
+#include "uart_framing.h"
+#include "uart_link.h"
+#include <iostream>
+#include <cstring>
+#include <vector>
+
+namespace uart {
+namespace test {
+
+extern int tests_run;
+extern int tests_passed;
+extern int tests_failed;
+extern void reportTest(const char* name, bool passed);
+
+#define TEST(name, condition) \
+    reportTest(name, (condition))
+
+struct FrameLog {
+    std::vector<std::vector<uint8_t> > frames;
+};
+
+static void recordFrame(const uint8_t* frame, size_t length, void* context) {
+    FrameLog* log = static_cast<FrameLog*>(context);
+    log->frames.push_back(std::vector<uint8_t>(frame, frame + length));
+}
+
+static bool cobsEncodes(const std::vector<uint8_t>& input, const std::vector<uint8_t>& expected) {
+    std::vector<uint8_t> out(CobsCodec::maxEncodedSize(input.size()));
+    size_t n = CobsCodec::encode(input.data(), input.size(), out.data());
+    out.resize(n);
+    return out == expected;
+}
+
+static std::vector<uint8_t> bytes(const uint8_t* data, size_t length) {
+    return std::vector<uint8_t>(data, data + length);
+}
+
+static std::vector<uint8_t> pattern(size_t length, uint32_t seed) {
+    std::vector<uint8_t> data(length);
+    for (size_t i = 0; i < length; i++) {
+        seed = seed * 1103515245 + 12345;
+        // Plenty of zeros and SLIP specials
+        uint8_t value = static_cast<uint8_t>(seed >> 16);
+        if ((seed >> 8) % 5 == 0) {
+            value = 0x00;
+        } else if ((seed >> 8) % 7 == 0) {
+            value = ((seed >> 12) & 1) ? SLIP_END : SLIP_ESC;
+        }
+        data[i] = value;
+    }
+    return data;
+}
+
+// Encode frames back to back, feed in uneven chunks, compare decoded frames
+template <typename Codec>
+static bool roundTrip(size_t chunk) {
+    std::vector<std::vector<uint8_t> > sent;
+    std::vector<uint8_t> stream;
+    const size_t lengths[] = {1, 2, 253, 254, 255, 300, 508, 600, 17};
+    for (size_t i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++) {
+        sent.push_back(pattern(lengths[i], static_cast<uint32_t>(i + 1)));
+        std::vector<uint8_t> encoded(Codec::maxEncodedSize(lengths[i]));
+        size_t n = Codec::encode(sent.back().data(), lengths[i], encoded.data());
+        stream.insert(stream.end(), encoded.begin(), encoded.begin() + n);
+    }
+    
+    typename Codec::Decoder decoder(1024);
+    FrameLog log;
+    for (size_t pos = 0; pos < stream.size(); pos += chunk) {
+        size_t n = (stream.size() - pos < chunk) ? stream.size() - pos : chunk;
+        decoder.feed(&stream[pos], n, &recordFrame, &log);
+    }
+    return log.frames == sent && decoder.getStats().errors == 0;
+}
+
+void testCobsVectors() {
+    std::cout << "\n=== COBS Encoding Tests ===" << std::endl;
+    
+    const uint8_t in1[] = {0x00};
+    const uint8_t out1[] = {0x01, 0x01, 0x00};
+    TEST("COBS single zero", cobsEncodes(bytes(in1, 1), bytes(out1, 3)));
+    
+    const uint8_t in2[] = {0x11, 0x22, 0x00, 0x33};
+    const uint8_t out2[] = {0x03, 0x11, 0x22, 0x02, 0x33, 0x00};
+    TEST("COBS embedded zero", cobsEncodes(bytes(in2, 4), bytes(out2, 6)));
+    
+    const uint8_t in3[] = {0x11, 0x00, 0x00, 0x00};
+    const uint8_t out3[] = {0x02, 0x11, 0x01, 0x01, 0x01, 0x00};
+    TEST("COBS trailing zeros", cobsEncodes(bytes(in3, 4), bytes(out3, 6)));
+    
+    std::vector<uint8_t> run254(254);
+    std::vector<uint8_t> enc254(1, 0xFF);
+    for (size_t i = 0; i < 254; i++) {
+        run254[i] = static_cast<uint8_t>(i + 1);
+    }
+    enc254.insert(enc254.end(), run254.begin(), run254.end());
+    enc254.push_back(0x00);
+    TEST("COBS 254 non-zero bytes", cobsEncodes(run254, enc254));
+    
+    std::vector<uint8_t> run255 = run254;
+    run255.push_back(0xFF);
+    std::vector<uint8_t> enc255(enc254.begin(), enc254.end() - 1);
+    enc255.push_back(0x02);
+    enc255.push_back(0xFF);
+    enc255.push_back(0x00);
+    TEST("COBS 255 non-zero bytes", cobsEncodes(run255, enc255));
+    
+    TEST("COBS round trip, whole stream", roundTrip<CobsCodec>(1 << 20));
+    TEST("COBS round trip, 1-byte chunks", roundTrip<CobsCodec>(1));
+    TEST("COBS round trip, 7-byte chunks", roundTrip<CobsCodec>(7));
+    
+    // Malformed: code byte points past the delimiter
+    CobsCodec::Decoder decoder(64);
+    const uint8_t bad[] = {0x05, 0x11, 0x22, 0x00};
+    FrameLog log;
+    decoder.feed(bad, sizeof(bad), &recordFrame, &log);
+    TEST("COBS malformed frame dropped", log.frames.empty() && decoder.getStats().errors == 1);
+    
+    std::vector<uint8_t> big(100, 0x42);
+    std::vector<uint8_t> encoded(CobsCodec::maxEncodedSize(big.size()));
+    size_t n = CobsCodec::encode(big.data(), big.size(), encoded.data());
+    decoder.feed(encoded.data(), n, &recordFrame, &log);
+    TEST("COBS oversized frame dropped", log.frames.empty() && decoder.getStats().overflows == 1);
+    decoder.feed(out2, sizeof(out2), &recordFrame, &log);
+    TEST("COBS decoder recovers", log.frames.size() == 1 && log.frames[0] == bytes(in2, 4));
+}
+
+void testSlipVectors() {
+    std::cout << "\n=== SLIP Encoding Tests ===" << std::endl;
+    
+    const uint8_t in[] = {0x01, SLIP_END, SLIP_ESC, 0x02};
+    const uint8_t expected[] = {SLIP_END, 0x01, SLIP_ESC, SLIP_ESC_END,
+                                SLIP_ESC, SLIP_ESC_ESC, 0x02, SLIP_END};
+    uint8_t out[16];
+    size_t n = SlipCodec::encode(in, sizeof(in), out);
+    TEST("SLIP escapes END and ESC", n == sizeof(expected) && memcmp(out, expected, n) == 0);
+    
+    TEST("SLIP round trip, whole stream", roundTrip<SlipCodec>(1 << 20));
+    TEST("SLIP round trip, 1-byte chunks", roundTrip<SlipCodec>(1));
+    TEST("SLIP round trip, 5-byte chunks", roundTrip<SlipCodec>(5));
+    
+    // ESC split from its code byte across feed() calls
+    SlipCodec::Decoder decoder(64);
+    FrameLog log;
+    decoder.feed(expected, 3, &recordFrame, &log);
+    decoder.feed(expected + 3, sizeof(expected) - 3, &recordFrame, &log);
+    TEST("SLIP escape spans chunks", log.frames.size() == 1 && log.frames[0] == bytes(in, sizeof(in)));
+    
+    const uint8_t bad[] = {SLIP_END, 0x01, SLIP_ESC, 0x55, SLIP_END};
+    decoder.feed(bad, sizeof(bad), &recordFrame, &log);
+    TEST("SLIP invalid escape dropped", log.frames.size() == 1 && decoder.getStats().errors == 1);
+}
+
+void testFrameChannel() {
+    std::cout << "\n=== Frame Channel Tests ===" << std::endl;
+    
+    UARTDriver a;
+    UARTDriver b;
+    a.initialize(115200);
+    b.initialize(115200);
+    UARTLink link(a, b, true);
+    CobsChannel tx(a, 512);
+    CobsChannel rx(b, 512);
+    
+    std::vector<std::vector<uint8_t> > sent;
+    for (size_t i = 0; i < 20; i++) {
+        sent.push_back(pattern(1 + i * 23, static_cast<uint32_t>(100 + i)));
+    }
+    
+    // Frames far larger than the 16-byte FIFOs, pumped through the link
+    FrameLog log;
+    size_t next = 0;
+    for (int round = 0; round < 5000 && log.frames.size() < sent.size(); round++) {
+        if (next < sent.size() && tx.sendFrame(sent[next].data(), sent[next].size())) {
+            next++;
+        }
+        tx.flush();
+        link.transfer();
+        rx.receive(&recordFrame, &log);
+    }
+    
+    TEST("All frames delivered", log.frames == sent);
+    TEST("No decode errors", rx.getDecoder().getStats().errors == 0);
+    TEST("Oversized frame refused", !tx.sendFrame(sent[0].data(), 513));
+    TEST("No overruns", !b.hasError());
+}
+
+int runFramingTests() {
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "Running Framing Tests" << std::endl;
+    std::cout << "========================================" << std::endl;
+    
+    testCobsVectors();
+    testSlipVectors();
+    testFrameChannel();
+    
+    return tests_failed;
+}
+
+} // namespace test
+} // namespace uart
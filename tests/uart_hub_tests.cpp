@@ -0,0 +1,129 @@
+#include "uart_hub.h"
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace uart {
+namespace test {
+
+extern int tests_run;
+extern int tests_passed;
+extern int tests_failed;
+extern void reportTest(const char* name, bool passed);
+
+#define TEST(name, condition) \
+    reportTest(name, (condition))
+
+void testHubReadiness() {
+    std::cout << "\n=== Hub Readiness Tests ===" << std::endl;
+    
+    UARTHub hub(200, 2);
+    TEST("Hub initializes all ports", hub.initialize(115200));
+    
+    PortEvent events[200];
+    TEST("No readable ports after init", hub.poll(events, 200) == 0);
+    
+    uint8_t data[4] = {1, 2, 3, 4};
+    hub.port(3).simulateReceive(data, 4);
+    hub.port(130).simulateReceive(data, 2);
+    
+    size_t ready = hub.poll(events, 200);
+    TEST("Two readable ports", ready == 2);
+    TEST("Ready ports reported in order",
+         ready == 2 && events[0].port == 3 && events[1].port == 130);
+    TEST("Readable event reported", ready == 2 && events[0].events == HUB_READABLE);
+    
+    // Level-triggered: still ready until drained
+    TEST("Port stays ready until drained", hub.poll(events, 200) == 2);
+    uint8_t buffer[16];
+    hub.port(3).readData(buffer, sizeof(buffer));
+    ready = hub.poll(events, 200);
+    TEST("Drained port drops out", ready == 1 && events[0].port == 130);
+    
+    // Writable interest
+    hub.setInterest(7, HUB_WRITABLE);
+    ready = hub.poll(events, 200);
+    TEST("Writable interest reports TX space", ready == 2 && events[0].port == 7 &&
+         events[0].events == HUB_WRITABLE);
+    
+    uint8_t fill[FIFO_DEPTH] = {0};
+    hub.port(7).writeData(fill, FIFO_DEPTH);
+    ready = hub.poll(events, 200);
+    TEST("Full TX FIFO not writable", ready == 1 && events[0].port == 130);
+    
+    hub.port(7).simulateTransmit(1);
+    ready = hub.poll(events, 200);
+    TEST("Space above low water not reported", ready == 1 && hub.port(7).canTransmit());
+    
+    hub.port(7).simulateTransmit(FIFO_DEPTH / 4 - 1);
+    ready = hub.poll(events, 200);
+    TEST("TX low water re-arms writable", ready == 2 && events[0].port == 7);
+}
+
+void testHubService() {
+    std::cout << "\n=== Hub Service Tests ===" << std::endl;
+    
+    const size_t num_ports = 256;
+    UARTHub hub(num_ports, 4);
+    hub.initialize(115200);
+    
+    uint8_t data[8] = {0};
+    for (size_t i = 0; i < num_ports; i += 2) {
+        hub.port(i).simulateReceive(data, 8);
+    }
+    
+    std::atomic<size_t> bytes(0);
+    std::atomic<size_t> calls(0);
+    size_t serviced = hub.service([&](size_t port, uint32_t events, UARTDriver& uart) {
+        (void)port;
+        uint8_t buffer[FIFO_DEPTH];
+        if (events & HUB_READABLE) {
+            bytes += uart.readData(buffer, sizeof(buffer));
+        }
+        calls++;
+    });
+    
+    TEST("Service visits every ready port", serviced == num_ports / 2 && calls == num_ports / 2);
+    TEST("Service drains all data", bytes == (num_ports / 2) * 8);
+    TEST("Nothing ready after service", hub.service([](size_t, uint32_t, UARTDriver&) {}) == 0);
+}
+
+void testWorkStealing() {
+    std::cout << "\n=== Worker Pool Stealing Tests ===" << std::endl;
+    
+    WorkerPool pool(4);
+    std::vector<size_t> items(64);
+    for (size_t i = 0; i < items.size(); i++) {
+        items[i] = i;
+    }
+    
+    // Item 0 is hot: its worker is busy while the rest of its shard waits
+    std::atomic<size_t> done(0);
+    pool.run(items.data(), items.size(), [&done](size_t item) {
+        if (item == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        }
+        done++;
+    });
+    
+    TEST("All items processed", done == items.size());
+    TEST("Idle workers stole from the hot shard", pool.getStealCount() > 0);
+}
+
+int runHubTests() {
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "Running Hub Tests" << std::endl;
+    std::cout << "========================================" << std::endl;
+    
+    testHubReadiness();
+    testHubService();
+    testWorkStealing();
+    
+    return tests_failed;
+}
+
+} // namespace test
+} // namespace uart
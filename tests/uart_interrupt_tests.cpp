@@ -0,0 +1,132 @@
+#include "uart_driver.h"
+#include <iostream>
+#include <cstring>
+
+namespace uart {
+namespace test {
+
+extern int tests_run;
+extern int tests_passed;
+extern int tests_failed;
+extern void reportTest(const char* name, bool passed);
+
+#define TEST(name, condition) \
+    reportTest(name, (condition))
+
+struct InterruptLog {
+    int calls;
+    uint32_t last_pending;
+    size_t bytes_read;
+    UARTDriver* uart;
+};
+
+static void recordInterrupt(uint32_t pending, void* context) {
+    InterruptLog* log = static_cast<InterruptLog*>(context);
+    log->calls++;
+    log->last_pending = pending;
+    
+    // Batch-drain the RX FIFO like an ISR would
+    if (log->uart && (pending & INT_RX_TRIGGER)) {
+        uint8_t buffer[FIFO_DEPTH];
+        log->bytes_read += log->uart->readData(buffer, sizeof(buffer));
+    }
+}
+
+void testTriggerLevels() {
+    std::cout << "\n=== Trigger Level Tests ===" << std::endl;
+    
+    UARTDriver uart;
+    uart.initialize(115200);
+    
+    uart.configureInterrupts(0, FCR_RX_TRIG_1 | FCR_TX_LOW_EMPTY);
+    TEST("RX trigger 1 byte", uart.getRxTriggerLevel() == 1);
+    TEST("TX low water empty", uart.getTxLowWaterLevel() == 0);
+    uart.configureInterrupts(0, FCR_RX_TRIG_QUARTER | FCR_TX_LOW_HALF);
+    TEST("RX trigger 4 bytes", uart.getRxTriggerLevel() == 4);
+    TEST("TX low water 8 bytes", uart.getTxLowWaterLevel() == 8);
+    uart.configureInterrupts(0, FCR_RX_TRIG_HALF);
+    TEST("RX trigger 8 bytes", uart.getRxTriggerLevel() == 8);
+    uart.configureInterrupts(0, FCR_RX_TRIG_NEAR_FULL);
+    TEST("RX trigger 14 bytes", uart.getRxTriggerLevel() == 14);
+}
+
+void testRxTriggerInterrupt() {
+    std::cout << "\n=== RX Trigger Interrupt Tests ===" << std::endl;
+    
+    UARTDriver uart;
+    uart.initialize(115200);
+    
+    InterruptLog log = {0, 0, 0, &uart};
+    uart.setInterruptHandler(&recordInterrupt, &log);
+    uart.configureInterrupts(INT_RX_TRIGGER, FCR_RX_TRIG_HALF);
+    
+    uint8_t data[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+    uart.simulateReceive(data, 4);
+    TEST("No interrupt below trigger level", log.calls == 0);
+    
+    uart.simulateReceive(data, 4);
+    TEST("Interrupt at trigger level", log.calls == 1);
+    TEST("Pending mask is RX trigger", log.last_pending == INT_RX_TRIGGER);
+    TEST("Handler drained the batch", log.bytes_read == 8 && !uart.hasData());
+    TEST("Pending bit latched", (uart.getPendingInterrupts() & INT_RX_TRIGGER) != 0);
+    
+    uart.clearInterrupts(INT_RX_TRIGGER);
+    TEST("Pending bit cleared", uart.getPendingInterrupts() == 0);
+}
+
+void testTxLowInterrupt() {
+    std::cout << "\n=== TX Low-Water Interrupt Tests ===" << std::endl;
+    
+    UARTDriver uart;
+    uart.initialize(115200);
+    
+    InterruptLog log = {0, 0, 0, nullptr};
+    uart.setInterruptHandler(&recordInterrupt, &log);
+    uart.configureInterrupts(INT_TX_LOW, FCR_TX_LOW_QUARTER);
+    
+    uint8_t data[FIFO_DEPTH] = {0};
+    uart.writeData(data, FIFO_DEPTH);
+    uart.simulateTransmit(8);
+    TEST("No interrupt above low water", log.calls == 0);
+    
+    uart.simulateTransmit(4);
+    TEST("Interrupt when level reaches low water", log.calls == 1 && log.last_pending == INT_TX_LOW);
+    
+    uart.simulateTransmit(4);
+    TEST("No repeat below low water", log.calls == 1);
+}
+
+void testLineErrorInterrupt() {
+    std::cout << "\n=== Line Error Interrupt Tests ===" << std::endl;
+    
+    UARTDriver uart;
+    uart.initialize(115200);
+    
+    InterruptLog log = {0, 0, 0, nullptr};
+    uart.setInterruptHandler(&recordInterrupt, &log);
+    uart.configureInterrupts(INT_LINE_ERROR, FCR_RX_TRIG_1);
+    
+    uint8_t data[FIFO_DEPTH + 1] = {0};
+    uart.simulateReceive(data, FIFO_DEPTH);
+    TEST("Disabled RX trigger does not call handler", log.calls == 0);
+    TEST("Disabled RX trigger still latched", (uart.getPendingInterrupts() & INT_RX_TRIGGER) != 0);
+    
+    uart.simulateReceive(data, 1);
+    TEST("Overrun raises line error", log.calls == 1 && log.last_pending == INT_LINE_ERROR);
+}
+
+int runInterruptTests() {
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "Running Interrupt Tests" << std::endl;
+    std::cout << "========================================" << std::endl;
+    
+    testTriggerLevels();
+    testRxTriggerInterrupt();
+    testTxLowInterrupt();
+    testLineErrorInterrupt();
+    
+    return tests_failed;
+}
+
+} // namespace test
+} // namespace uart
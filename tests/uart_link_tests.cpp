@@ -0,0 +1,174 @@
+#include "uart_link.h"
+#include <iostream>
+#include <cstring>
+#include <vector>
+
+namespace uart {
+namespace test {
+
+extern int tests_run;
+extern int tests_passed;
+extern int tests_failed;
+extern void reportTest(const char* name, bool passed);
+
+#define TEST(name, condition) \
+    reportTest(name, (condition))
+
+void testLinkLoopback() {
+    std::cout << "\n=== Link Loopback Tests ===" << std::endl;
+    
+    UARTDriver a;
+    UARTDriver b;
+    a.initialize(115200);
+    b.initialize(115200);
+    UARTLink link(a, b);
+    
+    const uint8_t ping[] = "PING";
+    const uint8_t pong[] = "PONG!";
+    a.writeData(ping, 4);
+    b.writeData(pong, 5);
+    
+    size_t moved = link.transfer();
+    TEST("Both directions moved", moved == 9);
+    TEST("A's TX drained", a.getTxFifoCount() == 0);
+    
+    uint8_t buffer[16];
+    size_t got = b.readData(buffer, sizeof(buffer));
+    TEST("B received A's bytes", got == 4 && memcmp(buffer, ping, 4) == 0);
+    got = a.readData(buffer, sizeof(buffer));
+    TEST("A received B's bytes", got == 5 && memcmp(buffer, pong, 5) == 0);
+    
+    TEST("Link counts A->B bytes", link.getStats(UARTLink::A_TO_B).bytes == 4);
+    TEST("Link counts B->A bytes", link.getStats(UARTLink::B_TO_A).bytes == 5);
+    TEST("Peer stats see line traffic", a.getStats().tx_bytes == 4 && b.getStats().rx_bytes == 4);
+    TEST("Idle link moves nothing", link.transfer() == 0);
+}
+
+void testLinkParity() {
+    std::cout << "\n=== Link Parity Tests ===" << std::endl;
+    
+    UARTDriver a;
+    UARTDriver b;
+    a.initialize(115200, true, true);
+    b.initialize(115200, true, true);
+    UARTLink link(a, b);
+    
+    uint8_t data[12];
+    for (int i = 0; i < 12; i++) {
+        data[i] = static_cast<uint8_t>(i * 37);
+    }
+    a.writeData(data, sizeof(data));
+    link.runToIdle();
+    TEST("Matching parity passes", !b.hasError() && b.getRxFifoCount() == 12);
+    
+    // Mismatched configuration: the receiver expects even parity
+    uint8_t drained[FIFO_DEPTH];
+    b.readData(drained, sizeof(drained));
+    b.initialize(115200, true, false);
+    a.writeData(data, sizeof(data));
+    link.runToIdle();
+    TEST("Mismatched parity flags frame errors", (b.readStatus() & STATUS_FRAME_ERR) != 0);
+    TEST("Every character fails the check", b.getStats().frame_errors == 12);
+}
+
+void testLinkFlowControl() {
+    std::cout << "\n=== Link Flow Control Tests ===" << std::endl;
+    
+    uint8_t data[40];
+    for (int i = 0; i < 40; i++) {
+        data[i] = static_cast<uint8_t>(i);
+    }
+    
+    // Free-running line: the receiver overruns
+    {
+        UARTDriver a;
+        UARTDriver b;
+        a.initialize(115200);
+        b.initialize(115200);
+        UARTLink link(a, b);
+        a.writeData(data, FIFO_DEPTH);
+        link.runToIdle();
+        a.writeData(data, FIFO_DEPTH);
+        link.runToIdle();
+        TEST("No flow control overruns the peer", (b.readStatus() & STATUS_OVERRUN) != 0);
+        TEST("Overrun bytes dropped", b.getStats().rx_dropped_bytes == FIFO_DEPTH);
+    }
+    
+    // Crossed flow control: the sender holds data until the peer has room
+    {
+        UARTDriver a;
+        UARTDriver b;
+        a.initialize(115200);
+        b.initialize(115200);
+        UARTLink link(a, b, true);
+        a.writeData(data, FIFO_DEPTH);
+        link.runToIdle();
+        a.writeData(data, 10);
+        link.runToIdle();
+        TEST("Flow control prevents overrun", !b.hasError());
+        TEST("Sender keeps unsent bytes", a.getTxFifoCount() == 10);
+        TEST("Stall recorded", link.getStats(UARTLink::A_TO_B).stalls > 0);
+        
+        uint8_t buffer[FIFO_DEPTH];
+        b.readData(buffer, 6);
+        link.runToIdle();
+        TEST("Peer space releases the sender", a.getTxFifoCount() == 4 && b.getRxFifoCount() == FIFO_DEPTH);
+    }
+}
+
+void testLinkDuplexThroughput() {
+    std::cout << "\n=== Link Full-Duplex Tests ===" << std::endl;
+    
+    UARTDriver a;
+    UARTDriver b;
+    a.initialize(115200);
+    b.initialize(115200);
+    SoftwareBufferConfig config;
+    config.tx_capacity = 4096;
+    config.rx_capacity = 1024;
+    a.attachSoftwareBuffers(config);
+    b.attachSoftwareBuffers(config);
+    UARTLink link(a, b, true);
+    
+    std::vector<uint8_t> out_a(3000);
+    std::vector<uint8_t> out_b(3000);
+    for (size_t i = 0; i < out_a.size(); i++) {
+        out_a[i] = static_cast<uint8_t>(i * 7 + 1);
+        out_b[i] = static_cast<uint8_t>(i * 13 + 5);
+    }
+    a.writeData(out_a.data(), out_a.size());
+    b.writeData(out_b.data(), out_b.size());
+    
+    // Both applications drain between link slices
+    std::vector<uint8_t> in_a;
+    std::vector<uint8_t> in_b;
+    uint8_t buffer[512];
+    for (int round = 0; round < 100; round++) {
+        link.transfer(512);
+        size_t n = a.readData(buffer, sizeof(buffer));
+        in_a.insert(in_a.end(), buffer, buffer + n);
+        n = b.readData(buffer, sizeof(buffer));
+        in_b.insert(in_b.end(), buffer, buffer + n);
+    }
+    
+    TEST("A->B stream intact", in_b == out_a);
+    TEST("B->A stream intact", in_a == out_b);
+    TEST("No overruns with flow control", !a.hasError() && !b.hasError());
+    TEST("Moved in blocks", link.getStats(UARTLink::A_TO_B).blocks < out_a.size() / 8);
+}
+
+int runLinkTests() {
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "Running Link Tests" << std::endl;
+    std::cout << "========================================" << std::endl;
+    
+    testLinkLoopback();
+    testLinkParity();
+    testLinkFlowControl();
+    testLinkDuplexThroughput();
+    
+    return tests_failed;
+}
+
+} // namespace test
+} // namespace uart
@@ -0,0 +1,101 @@
+#include "uart_driver.h"
+#include <iostream>
+#include <cstdio>
+#include <cstring>
+
+namespace uart {
+namespace test {
+
+extern int tests_run;
+extern int tests_passed;
+extern int tests_failed;
+extern void reportTest(const char* name, bool passed);
+
+#define TEST(name, condition) \
+    reportTest(name, (condition))
+
+static uint32_t word(const volatile uint32_t* block, uint32_t offset) {
+    return block[offset / sizeof(uint32_t)];
+}
+
+void testMappedRegisterBackend() {
+    std::cout << "\n=== Mapped Register Backend Tests ===" << std::endl;
+    
+    volatile uint32_t block[REGISTER_BLOCK_SIZE / sizeof(uint32_t)] = {0};
+    MappedUARTDriver uart(block);
+    TEST("Mapped driver initializes", uart.initialize(9600, true, true));
+    TEST("Baud rate lands in the block", word(block, UART_BAUD_REG) == 9600);
+    TEST("Control lands in the block",
+         word(block, UART_CONTROL_REG) == (CTRL_ENABLE | CTRL_TX_ENABLE | CTRL_RX_ENABLE |
+                                           CTRL_PARITY_EN | CTRL_PARITY_ODD));
+    
+    // Same data path as the simulated backend
+    uint8_t data[4] = {0x10, 0x20, 0x30, 0x40};
+    TEST("Write through mapped driver", uart.writeData(data, 4) == 4);
+    TEST("FIFO status derived on read", (uart.readStatus() & STATUS_TX_EMPTY) == 0);
+    uart.simulateTransmit(4);
+    TEST("TX empty after transmit", (uart.readStatus() & STATUS_TX_EMPTY) != 0);
+    
+    uint8_t burst[FIFO_DEPTH + 2] = {0};
+    uart.simulateReceive(burst, sizeof(burst));
+    TEST("Overrun latched in the block", (word(block, UART_STATUS_REG) & STATUS_OVERRUN) != 0);
+    uart.clearErrors();
+    TEST("Error bits are write-1-to-clear", (word(block, UART_STATUS_REG) & STATUS_OVERRUN) == 0);
+    
+    // Another agent on the window (e.g. a co-simulator) changes the control register
+    block[UART_CONTROL_REG / sizeof(uint32_t)] = CTRL_ENABLE | CTRL_RX_ENABLE;
+    TEST("Driver sees external register writes", !uart.writeByte(0x55));
+    
+    uart.configureInterrupts(INT_RX_TRIGGER, FCR_RX_TRIG_1);
+    TEST("Interrupt enable masked into the block", word(block, UART_INT_ENABLE_REG) == INT_RX_TRIGGER);
+    
+    MappedUARTRegisters regs(block);
+    regs.writeRegister(UART_DATA_REG, 0x1AB);
+    TEST("Data register keeps 8 bits", regs.readRegister(UART_DATA_REG) == 0xAB);
+    TEST("Invalid offsets read as zero", regs.readRegister(0x40) == 0 && regs.readRegister(0x02) == 0);
+}
+
+void testRegisterWindow() {
+    std::cout << "\n=== Register Window Tests ===" << std::endl;
+    
+#if defined(__unix__) || defined(__APPLE__)
+    const char* path = "uart_register_window.bin";
+    std::remove(path);
+    
+    RegisterWindow device_side;
+    RegisterWindow observer;
+    TEST("Window created from a file", device_side.open(path));
+    TEST("Second mapping of the same file", observer.open(path));
+    
+    {
+        MappedUARTDriver uart(device_side.get());
+        uart.initialize(115200);
+        TEST("Other mapping sees the baud rate", word(observer.get(), UART_BAUD_REG) == 115200);
+        uart.configureInterrupts(INT_LINE_ERROR, 0);
+        uint8_t burst[FIFO_DEPTH + 1] = {0};
+        uart.simulateReceive(burst, sizeof(burst));
+        TEST("Other mapping sees latched errors", (word(observer.get(), UART_STATUS_REG) & STATUS_OVERRUN) != 0);
+        TEST("Other mapping sees pending interrupts",
+             (word(observer.get(), UART_INT_STATUS_REG) & INT_LINE_ERROR) != 0);
+    }
+    
+    observer.close();
+    device_side.close();
+    TEST("Closed window releases the block", device_side.get() == nullptr);
+    std::remove(path);
+#endif
+}
+
+int runMappedRegisterTests() {
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "Running Mapped Register Tests" << std::endl;
+    std::cout << "========================================" << std::endl;
+    
+    testMappedRegisterBackend();
+    testRegisterWindow();
+    
+    return tests_failed;
+}
+
+} // namespace test
+} // namespace uart
@@ -0,0 +1,180 @@
+#include "uart_driver.h"
+#include <iostream>
+#include <cstring>
+#include <vector>
+
+namespace uart {
+namespace test {
+
+extern int tests_run;
+extern int tests_passed;
+extern int tests_failed;
+extern void reportTest(const char* name, bool passed);
+
+#define TEST(name, condition) \
+    reportTest(name, (condition))
+
+static bool referenceParity(uint8_t value, bool odd) {
+    int ones = 0;
+    for (int bit = 0; bit < 8; bit++) {
+        ones += (value >> bit) & 1;
+    }
+    return ((ones & 1) != 0) != odd;
+}
+
+void testParityKernel() {
+    std::cout << "\n=== Parity Kernel Tests ===" << std::endl;
+    
+    std::vector<uint8_t> data(261);
+    uint32_t seed = 12345;
+    for (size_t i = 0; i < data.size(); i++) {
+        seed = seed * 1103515245 + 12345;
+        data[i] = static_cast<uint8_t>(seed >> 16);
+    }
+    
+    bool even_ok = true;
+    bool odd_ok = true;
+    for (size_t length = 0; length <= data.size(); length += 13) {
+        std::vector<uint8_t> bits(parityMaskBytes(length) + 1, 0xEE);
+        computeParityBits(data.data(), length, false, bits.data());
+        for (size_t i = 0; i < length; i++) {
+            bool bit = (bits[i / 8] >> (i % 8)) & 1;
+            even_ok = even_ok && bit == referenceParity(data[i], false);
+        }
+        even_ok = even_ok && bits[parityMaskBytes(length)] == 0xEE;
+    
+        computeParityBits(data.data(), length, true, bits.data());
+        for (size_t i = 0; i < length; i++) {
+            bool bit = (bits[i / 8] >> (i % 8)) & 1;
+            odd_ok = odd_ok && bit == referenceParity(data[i], true);
+        }
+    }
+    TEST("Even parity matches reference", even_ok);
+    TEST("Odd parity matches reference", odd_ok);
+    
+    size_t length = 21;
+    uint8_t bits[3];
+    uint8_t mask[3];
+    computeParityBits(data.data(), length, false, bits);
+    TEST("Generated bits check clean", checkParityBits(data.data(), length, false, bits, mask) == 0);
+    TEST("Clean mask is zero", mask[0] == 0 && mask[1] == 0 && mask[2] == 0);
+    
+    bits[0] ^= 0x04;
+    bits[2] ^= 0x10;
+    TEST("Flipped bits are counted", checkParityBits(data.data(), length, false, bits, mask) == 2);
+    TEST("Mask marks flipped characters", mask[0] == 0x04 && mask[1] == 0 && mask[2] == 0x10);
+    TEST("Wrong sense fails every character",
+         checkParityBits(data.data(), length, true, bits, nullptr) == length - 2);
+    
+    // Sub-ranges at every bit offset agree with the full mask
+    bool ranges_ok = true;
+    for (size_t offset = 0; offset < length; offset++) {
+        for (size_t count = 0; offset + count <= length; count++) {
+            size_t expected = 0;
+            for (size_t i = offset; i < offset + count; i++) {
+                expected += (mask[i / 8] >> (i % 8)) & 1;
+            }
+            ranges_ok = ranges_ok &&
+                countParityErrors(data.data() + offset, count, false, bits, offset) == expected &&
+                countMaskBits(mask, offset, count) == expected;
+        }
+    }
+    TEST("Offset error counts match the mask", ranges_ok);
+    
+    uint8_t cleared[3] = {0xFF, 0xFF, 0xFF};
+    clearMaskBits(cleared, 5, 12);
+    TEST("Mask range cleared across bytes", cleared[0] == 0x1F && cleared[1] == 0x00 && cleared[2] == 0xFE);
+}
+
+void testParityDataPath() {
+    std::cout << "\n=== Parity Data Path Tests ===" << std::endl;
+    
+    UARTDriver tx;
+    UARTDriver rx;
+    tx.initialize(115200, true, true);
+    rx.initialize(115200, true, true);
+    
+    uint8_t message[12];
+    for (int i = 0; i < 12; i++) {
+        message[i] = static_cast<uint8_t>(0x30 + i * 7);
+    }
+    tx.writeData(message, sizeof(message));
+    
+    uint8_t line[FIFO_DEPTH];
+    uint8_t parity[2];
+    uint8_t mask[2] = {0xFF, 0xFF};
+    size_t sent = tx.drainTx(line, sizeof(line), parity);
+    TEST("drainTx returns queued characters", sent == 12 && memcmp(line, message, 12) == 0);
+    TEST("drainTx empties the TX FIFO", tx.getTxFifoCount() == 0);
+    
+    rx.simulateReceive(line, sent, parity, mask);
+    TEST("Matching parity raises no error", !rx.hasError());
+    TEST("Matching parity mask is clear", mask[0] == 0 && mask[1] == 0);
+    TEST("Characters delivered", rx.getRxFifoCount() == 12);
+    
+    uint8_t drained[FIFO_DEPTH];
+    rx.readData(drained, sizeof(drained));
+    
+    rx.configureInterrupts(INT_LINE_ERROR, 0);
+    parity[1] ^= 0x02;
+    rx.simulateReceive(line, sent, parity, mask);
+    TEST("Parity error sets frame error", (rx.readStatus() & STATUS_FRAME_ERR) != 0);
+    TEST("Parity error is not an overrun", (rx.readStatus() & STATUS_OVERRUN) == 0);
+    TEST("Parity error latches line error interrupt", (rx.getPendingInterrupts() & INT_LINE_ERROR) != 0);
+    TEST("Mask marks the bad character", mask[0] == 0 && mask[1] == 0x02);
+    TEST("Bad character still delivered", rx.getRxFifoCount() == 12);
+    
+    rx.clearErrors();
+    TEST("Frame error clears", !rx.hasError());
+    
+    // Bad parity on characters dropped by overrun is not reported
+    uint64_t frame_errors = rx.getStats().frame_errors;
+    rx.clearInterrupts(INT_LINE_ERROR);
+    rx.simulateReceive(line, sent, parity, mask);
+    TEST("Dropped bad character cleared from the mask", mask[0] == 0 && mask[1] == 0);
+    TEST("Dropped bad character raises no frame error", (rx.readStatus() & STATUS_FRAME_ERR) == 0);
+    TEST("Dropped bad character not counted", rx.getStats().frame_errors == frame_errors);
+    TEST("Overrun still reported", (rx.readStatus() & STATUS_OVERRUN) != 0);
+    
+    // XON/XOFF characters consumed by flow control are not checked
+    UARTDriver soft;
+    soft.initialize(115200, true, true);
+    soft.configureFlowControl(CTRL_XONXOFF);
+    uint8_t flow[4] = {0x41, XON_CHAR, 0x42, 0x43};
+    uint8_t flow_parity[1];
+    computeParityBits(flow, sizeof(flow), true, flow_parity);
+    flow_parity[0] ^= 0x02;
+    uint8_t flow_mask[1] = {0xFF};
+    soft.simulateReceive(flow, sizeof(flow), flow_parity, nullptr);
+    TEST("Bad parity on XON not reported", !soft.hasError() && soft.getStats().frame_errors == 0);
+    soft.simulateReceive(flow, sizeof(flow), flow_parity, flow_mask);
+    TEST("Bad parity on XON not in the mask", flow_mask[0] == 0 && soft.getStats().frame_errors == 0);
+    flow_parity[0] ^= 0x06;
+    soft.simulateReceive(flow, sizeof(flow), flow_parity, nullptr);
+    TEST("Bad parity after XON found at its offset", soft.hasError() && soft.getStats().frame_errors == 1);
+    soft.simulateReceive(flow, sizeof(flow), flow_parity, flow_mask);
+    TEST("Mask and count agree after XON", flow_mask[0] == 0x04 && soft.getStats().frame_errors == 2);
+    
+    // Parity disabled: bits are ignored and the mask comes back clear
+    UARTDriver plain;
+    plain.initialize(115200);
+    parity[0] = 0xFF;
+    plain.simulateReceive(line, sent, parity, mask);
+    TEST("Parity ignored when disabled", !plain.hasError() && mask[0] == 0 && mask[1] == 0);
+    TEST("drainTx leaves parity untouched when disabled",
+         plain.drainTx(line, sizeof(line), parity) == 0 && parity[0] == 0xFF);
+}
+
+int runParityTests() {
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "Running Parity Tests" << std::endl;
+    std::cout << "========================================" << std::endl;
+    
+    testParityKernel();
+    testParityDataPath();
+    
+    return tests_failed;
+}
+
+} // namespace test
+} // namespace uart
@@ -0,0 +1,134 @@
+#include "uart_port_table.h"
+#include "uart_driver.h"
+#include <iostream>
+#include <cstring>
+#include <vector>
+
+namespace uart {
+namespace test {
+
+extern int tests_run;
+extern int tests_passed;
+extern int tests_failed;
+extern void reportTest(const char* name, bool passed);
+
+#define TEST(name, condition) \
+    reportTest(name, (condition))
+
+void testPortTableData() {
+    std::cout << "\n=== Port Table Data Tests ===" << std::endl;
+    
+    UARTPortTable table(4);
+    TEST("Table initializes", table.initializeAll(115200));
+    TEST("Baud rate stored", table.getBaudRate(2) == 115200);
+    TEST("Fresh port status", table.readStatus(1) == (STATUS_TX_EMPTY | STATUS_RX_EMPTY));
+    
+    uint8_t data[20];
+    for (int i = 0; i < 20; i++) {
+        data[i] = static_cast<uint8_t>(i + 1);
+    }
+    TEST("Write stops at FIFO depth", table.writeData(1, data, 20) == FIFO_DEPTH);
+    TEST("TX full status", (table.readStatus(1) & STATUS_TX_FULL) != 0);
+    TEST("Other ports untouched", table.getTxFifoCount(0) == 0 && table.getTxFifoCount(2) == 0);
+    
+    // Wrap the TX ring and check order on the way out
+    uint8_t out[FIFO_DEPTH];
+    TEST("Partial drain", table.drainTx(1, out, 10) == 10 && out[0] == 1 && out[9] == 10);
+    TEST("Refill across the wrap", table.writeData(1, data + 16, 4) == 4);
+    TEST("Drain across the wrap", table.drainTx(1, out, FIFO_DEPTH) == 10 && out[0] == 11 && out[9] == 20);
+    TEST("TX empty again", table.getTxFifoCount(1) == 0);
+    
+    TEST("Receive fills RX", table.simulateReceive(3, data, 12).accepted == 12);
+    uint8_t byte = 0;
+    TEST("Read one byte", table.readByte(3, byte) && byte == 1);
+    ReceiveResult overrun = table.simulateReceive(3, data, 8);
+    TEST("Receive overruns", overrun.accepted == 5 && overrun.dropped == 3);
+    TEST("Overrun latched", (table.readStatus(3) & STATUS_OVERRUN) != 0 && table.hasError(3));
+    uint8_t rx[FIFO_DEPTH];
+    size_t n = table.readData(3, rx, sizeof(rx));
+    TEST("Read across the wrap", n == FIFO_DEPTH && rx[0] == 2 && rx[10] == 12 && rx[11] == 1 && rx[15] == 5);
+    table.clearErrors(3);
+    TEST("Errors cleared", !table.hasError(3));
+    
+    table.shutdown(0);
+    TEST("Shut down port rejects writes", !table.writeByte(0, 0x55));
+    ReceiveResult ignored = table.simulateReceive(0, data, 4);
+    TEST("Shut down port ignores the line", ignored.accepted == 0 && ignored.dropped == 4);
+    TEST("Shut down port transmits nothing", table.drainTx(0, out, FIFO_DEPTH) == 0);
+}
+
+void testPortTableReadiness() {
+    std::cout << "\n=== Port Table Readiness Tests ===" << std::endl;
+    
+    const size_t ports = 50000;
+    UARTPortTable table(ports);
+    table.initializeAll(115200);
+    
+    std::vector<PortEvent> events(ports);
+    TEST("No readable ports after init", table.poll(events.data(), ports) == 0);
+    
+    uint8_t data[4] = {1, 2, 3, 4};
+    table.simulateReceive(7, data, 4);
+    table.simulateReceive(255, data, 1);
+    table.simulateReceive(256, data, 1);
+    table.simulateReceive(ports - 1, data, 2);
+    size_t ready = table.poll(events.data(), ports);
+    TEST("Readable ports found across scan blocks", ready == 4);
+    TEST("Ready ports reported in order",
+         ready == 4 && events[0].port == 7 && events[1].port == 255 && events[2].port == 256 &&
+         events[3].port == ports - 1);
+    TEST("Readable event reported", ready == 4 && events[0].events == HUB_READABLE);
+    TEST("Poll respects max_events", table.poll(events.data(), 2) == 2 && events[1].port == 255);
+    
+    uint8_t drain[4];
+    table.readData(255, drain, sizeof(drain));
+    TEST("Drained port no longer ready", table.poll(events.data(), ports) == 3);
+    
+    table.setInterest(9, HUB_WRITABLE | HUB_ERROR);
+    table.setFrameError(11);
+    table.setInterest(11, HUB_ERROR);
+    ready = table.poll(events.data(), ports);
+    TEST("Writable and error interest reported",
+         ready == 5 && events[1].port == 9 && events[1].events == HUB_WRITABLE &&
+         events[2].port == 11 && events[2].events == HUB_ERROR);
+    
+    uint8_t fill[FIFO_DEPTH] = {0};
+    table.writeData(9, fill, FIFO_DEPTH);
+    uint8_t scan[16];
+    table.scanReady(0, 16, scan);
+    TEST("Full TX port not writable", scan[9] == 0 && scan[7] == HUB_READABLE && scan[11] == HUB_ERROR);
+    
+    table.shutdown(7);
+    table.scanReady(0, 16, scan);
+    TEST("Disabled port not readable", scan[7] == 0);
+}
+
+void testPortTableFootprint() {
+    std::cout << "\n=== Port Table Footprint Tests ===" << std::endl;
+    
+    TEST("16-byte FIFO counts stored in one byte", sizeof(UARTPortTable::Count) == 1);
+    TEST("Deep FIFO counts widen to 16 bits", sizeof(BasicUARTPortTable<256>::Count) == 2);
+    TEST("Per-port state far below a driver",
+         UARTPortTable::bytesPerPort() * 4 <= sizeof(UARTDriver));
+    
+    BasicUARTPortTable<256> deep(3);
+    deep.initializeAll(9600);
+    std::vector<uint8_t> data(300, 0xA5);
+    TEST("Deep port accepts a full FIFO", deep.writeData(2, data.data(), data.size()) == 256);
+    TEST("Deep port status full", (deep.readStatus(2) & STATUS_TX_FULL) != 0);
+}
+
+int runPortTableTests() {
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "Running Port Table Tests" << std::endl;
+    std::cout << "========================================" << std::endl;
+    
+    testPortTableData();
+    testPortTableReadiness();
+    testPortTableFootprint();
+    
+    return tests_failed;
+}
+
+} // namespace test
+} // namespace uart
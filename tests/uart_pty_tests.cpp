@@ -0,0 +1,246 @@
+#include "uart_pty.h"
+#include <chrono>
+#include <iostream>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+namespace uart {
+namespace test {
+
+extern int tests_run;
+extern int tests_passed;
+extern int tests_failed;
+extern void reportTest(const char* name, bool passed);
+
+#define TEST(name, condition) \
+    reportTest(name, (condition))
+
+#if defined(__linux__)
+
+// Read from a tool-side descriptor until length bytes arrive or it goes quiet
+static size_t readTool(int fd, uint8_t* buffer, size_t length) {
+    size_t got = 0;
+    while (got < length) {
+        struct pollfd pfd = {fd, POLLIN, 0};
+        if (::poll(&pfd, 1, 200) <= 0) {
+            break;
+        }
+        ssize_t n = read(fd, buffer + got, length - got);
+        if (n <= 0) {
+            break;
+        }
+        got += static_cast<size_t>(n);
+    }
+    return got;
+}
+
+void testPtyRoundTrip() {
+    std::cout << "\n=== PTY Round Trip Tests ===" << std::endl;
+    
+    UARTDriver uart;
+    uart.initialize(115200);
+    UARTPty pty;
+    int port = pty.addPort(uart);
+    TEST("PTY created", port == 0);
+    if (port < 0) {
+        return;
+    }
+    TEST("Slave path is a pts device", strncmp(pty.getPath(0), "/dev/pts/", 9) == 0);
+    
+    int tool = open(pty.getPath(0), O_RDWR | O_NOCTTY | O_NONBLOCK);
+    TEST("Tool can open the slave", tool >= 0);
+    if (tool < 0) {
+        return;
+    }
+    
+    // Tool -> driver RX
+    const uint8_t hello[] = "hello";
+    TEST("Tool write accepted", write(tool, hello, 5) == 5);
+    size_t moved = 0;
+    for (int i = 0; i < 20 && moved < 5; i++) {
+        moved += pty.poll(50);
+    }
+    uint8_t buffer[64];
+    size_t got = uart.readData(buffer, sizeof(buffer));
+    TEST("Driver received tool bytes", got == 5 && memcmp(buffer, hello, 5) == 0);
+    
+    // Driver TX -> tool
+    const uint8_t world[] = "world!";
+    uart.writeData(world, 6);
+    pty.wake(0);
+    pty.poll(0);
+    TEST("TX FIFO drained to the PTY", uart.getTxFifoCount() == 0);
+    got = readTool(tool, buffer, 6);
+    TEST("Tool received driver bytes", got == 6 && memcmp(buffer, world, 6) == 0);
+    
+    const PtyStats& stats = pty.getStats();
+    TEST("Stats count both directions", stats.bytes_in == 5 && stats.bytes_out == 6);
+    
+    close(tool);
+}
+
+void testPtyBackpressure() {
+    std::cout << "\n=== PTY Backpressure Tests ===" << std::endl;
+    
+    UARTDriver uart;
+    uart.initialize(115200);
+    UARTPty pty;
+    if (pty.addPort(uart) < 0) {
+        TEST("PTY created", false);
+        return;
+    }
+    int tool = open(pty.getPath(0), O_RDWR | O_NOCTTY | O_NONBLOCK);
+    
+    uint8_t data[100];
+    for (int i = 0; i < 100; i++) {
+        data[i] = static_cast<uint8_t>(i);
+    }
+    TEST("Tool burst accepted", write(tool, data, sizeof(data)) == 100);
+    
+    // Input beyond the RX FIFO stays in the PTY instead of overrunning
+    for (int i = 0; i < 5; i++) {
+        pty.poll(20);
+    }
+    TEST("Driver FIFO filled", uart.getRxFifoCount() == FIFO_DEPTH);
+    TEST("No overrun", !uart.hasError());
+    
+    std::vector<uint8_t> received;
+    uint8_t buffer[FIFO_DEPTH];
+    for (int i = 0; i < 200 && received.size() < 100; i++) {
+        size_t n = uart.readData(buffer, sizeof(buffer));
+        received.insert(received.end(), buffer, buffer + n);
+        pty.wake(0);
+        pty.poll(5);
+    }
+    TEST("Whole burst delivered in order",
+         received.size() == 100 && memcmp(received.data(), data, 100) == 0);
+    TEST("Still no overrun", !uart.hasError());
+    
+    close(tool);
+}
+
+void testPtyWake() {
+    std::cout << "\n=== PTY Wake Tests ===" << std::endl;
+    
+    UARTDriver uart;
+    uart.initialize(115200);
+    UARTPty pty;
+    if (pty.addPort(uart) < 0) {
+        TEST("PTY created", false);
+        return;
+    }
+    int tool = open(pty.getPath(0), O_RDWR | O_NOCTTY | O_NONBLOCK);
+    
+    // A poll(-1) with nothing to do must still see data queued afterwards
+    size_t moved = 0;
+    std::thread poller([&]() { moved = pty.poll(-1); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    const uint8_t late[] = "late";
+    uart.writeData(late, 4);
+    pty.wake(0);
+    poller.join();
+    TEST("Blocked poll returns after wake", moved == 4 && uart.getTxFifoCount() == 0);
+    TEST("Wake consumed", pty.getStats().kicks == 1);
+    
+    uint8_t buffer[8];
+    TEST("Tool received data queued during poll",
+         readTool(tool, buffer, 4) == 4 && memcmp(buffer, late, 4) == 0);
+    TEST("No pending wake left", pty.poll(0) == 0 && pty.getStats().kicks == 1);
+    
+    // Without a wake, queued output waits: poll() does not sweep idle ports
+    uart.writeData(late, 4);
+    TEST("Unwoken port left alone", pty.poll(0) == 0 && uart.getTxFifoCount() == 4);
+    pty.wake(0);
+    pty.wake(0);
+    TEST("Repeated wakes service the port once", pty.poll(0) == 4 && pty.getStats().kicks == 2);
+    readTool(tool, buffer, 4);
+    
+    close(tool);
+}
+
+void testPtyManyPortsBatched() {
+    std::cout << "\n=== PTY Multi-Port Batching Tests ===" << std::endl;
+    
+    const size_t num_ports = 8;
+    const size_t length = 3000;
+    std::unique_ptr<UARTDriver[]> drivers(new UARTDriver[num_ports]);
+    UARTPty pty;
+    std::vector<int> tools;
+    SoftwareBufferConfig config;
+    config.tx_capacity = 8192;
+    config.rx_capacity = 8192;
+    for (size_t p = 0; p < num_ports; p++) {
+        drivers[p].initialize(115200);
+        drivers[p].attachSoftwareBuffers(config);
+        if (pty.addPort(drivers[p]) < 0) {
+            TEST("PTYs created", false);
+            return;
+        }
+        tools.push_back(open(pty.getPath(p), O_RDWR | O_NOCTTY | O_NONBLOCK));
+    }
+    
+    std::vector<uint8_t> data(length);
+    for (size_t i = 0; i < length; i++) {
+        data[i] = static_cast<uint8_t>(i * 11);
+    }
+    for (size_t p = 0; p < num_ports; p++) {
+        drivers[p].writeData(data.data(), length);
+        pty.wake(p);
+    }
+    
+    // One thread serves every port
+    std::vector<std::vector<uint8_t> > at_tool(num_ports);
+    uint8_t buffer[1024];
+    for (int round = 0; round < 200; round++) {
+        pty.poll(5);
+        bool done = true;
+        for (size_t p = 0; p < num_ports; p++) {
+            ssize_t n = read(tools[p], buffer, sizeof(buffer));
+            if (n > 0) {
+                at_tool[p].insert(at_tool[p].end(), buffer, buffer + n);
+            }
+            done = done && at_tool[p].size() == length;
+        }
+        if (done) {
+            break;
+        }
+    }
+    
+    bool intact = true;
+    for (size_t p = 0; p < num_ports; p++) {
+        intact = intact && at_tool[p] == data;
+        close(tools[p]);
+    }
+    TEST("Every port's stream intact", intact);
+    TEST("Output written in blocks", pty.getStats().writes < num_ports * length / 64);
+}
+
+#endif // __linux__
+
+int runPtyTests() {
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "Running PTY Tests" << std::endl;
+    std::cout << "========================================" << std::endl;
+    
+#if defined(__linux__)
+    testPtyRoundTrip();
+    testPtyBackpressure();
+    testPtyWake();
+    testPtyManyPortsBatched();
+#else
+    std::cout << "PTY backend is Linux only; skipped" << std::endl;
+#endif
+    
+    return tests_failed;
+}
+
+} // namespace test
+} // namespace uart
@@ -0,0 +1,135 @@
+#include "uart_driver.h"
+#include <iostream>
+#include <cstring>
+
+namespace uart {
+namespace test {
+
+extern int tests_run;
+extern int tests_passed;
+extern int tests_failed;
+extern void reportTest(const char* name, bool passed);
+
+#define TEST(name, condition) \
+    reportTest(name, (condition))
+
+static void receiveString(UARTDriver& uart, const char* text) {
+    uart.simulateReceive(reinterpret_cast<const uint8_t*>(text), strlen(text));
+}
+
+void testReadUntil() {
+    std::cout << "\n=== readUntil Tests ===" << std::endl;
+    
+    UARTDriver uart;
+    uart.initialize(115200);
+    
+    uint8_t buffer[32];
+    size_t length = 99;
+    TEST("Empty FIFO has no record", !uart.readUntil(';', buffer, sizeof(buffer), length) && length == 0);
+    
+    receiveString(uart, "ab;cd");
+    TEST("Record found", uart.readUntil(';', buffer, sizeof(buffer), length));
+    TEST("Record includes the delimiter", length == 3 && memcmp(buffer, "ab;", 3) == 0);
+    TEST("Partial record not returned", !uart.readUntil(';', buffer, sizeof(buffer), length) && length == 0);
+    TEST("Partial record left in place", uart.getRxFifoCount() == 2);
+    
+    receiveString(uart, "e;");
+    TEST("Completed record found", uart.readUntil(';', buffer, sizeof(buffer), length));
+    TEST("Completed record intact", length == 4 && memcmp(buffer, "cde;", 4) == 0);
+    
+    // Put the read index 4 bytes before the end of the ring, so the
+    // delimiter lands in the wrapped second segment
+    uint8_t fill[FIFO_DEPTH];
+    memset(fill, 'x', sizeof(fill));
+    uart.simulateReceive(fill, FIFO_DEPTH - 4 - 5);
+    uart.readData(buffer, sizeof(buffer));
+    receiveString(uart, "abcdef;xy");
+    TEST("Wrapped record found", uart.readUntil(';', buffer, sizeof(buffer), length));
+    TEST("Wrapped record joined", length == 7 && memcmp(buffer, "abcdef;", 7) == 0);
+    TEST("Rest stays queued", uart.getRxFifoCount() == 2);
+    
+    uart.readData(buffer, sizeof(buffer));
+    receiveString(uart, "0123456789");
+    TEST("Overlong record read in pieces", !uart.readUntil(';', buffer, 4, length) && length == 4);
+    TEST("Piece holds the oldest bytes", memcmp(buffer, "0123", 4) == 0 && uart.getRxFifoCount() == 6);
+    TEST("Delimiter beyond max not matched", !uart.readUntil('9', buffer, 4, length) && length == 4);
+    
+    uart.shutdown();
+    TEST("RX disabled returns nothing", !uart.readUntil('9', buffer, sizeof(buffer), length) && length == 0);
+}
+
+void testReadLine() {
+    std::cout << "\n=== readLine Tests ===" << std::endl;
+    
+    UARTDriver uart;
+    uart.initialize(115200);
+    
+    char line[16];
+    size_t length = 0;
+    receiveString(uart, "OK\r\nAT\n+C");
+    TEST("CRLF line read", uart.readLine(line, sizeof(line), length));
+    TEST("CRLF stripped", length == 2 && strcmp(line, "OK") == 0);
+    TEST("LF line read", uart.readLine(line, sizeof(line), length) && strcmp(line, "AT") == 0);
+    TEST("Partial line not read", !uart.readLine(line, sizeof(line), length) && length == 0 && line[0] == '\0');
+    TEST("Partial line kept", uart.getRxFifoCount() == 2);
+    
+    receiveString(uart, "\n");
+    TEST("Line completed by a later LF", uart.readLine(line, sizeof(line), length) && strcmp(line, "+C") == 0);
+    receiveString(uart, "\r\n");
+    TEST("Blank line read", uart.readLine(line, sizeof(line), length) && length == 0);
+    
+    receiveString(uart, "abcdefgh");
+    TEST("Overlong line split", !uart.readLine(line, 5, length) && length == 4 && strcmp(line, "abcd") == 0);
+}
+
+void testReadLineBuffered() {
+    std::cout << "\n=== Buffered readLine Tests ===" << std::endl;
+    
+    static uint8_t tx_arena[256];
+    static uint8_t rx_arena[256];
+    
+    UARTDriver uart;
+    uart.initialize(115200);
+    SoftwareBufferConfig config;
+    config.tx_memory = tx_arena;
+    config.tx_capacity = sizeof(tx_arena);
+    config.rx_memory = rx_arena;
+    config.rx_capacity = sizeof(rx_arena);
+    uart.attachSoftwareBuffers(config);
+    
+    char text[121];
+    memset(text, 'q', 120);
+    text[120] = '\0';
+    uint8_t drain[256];
+    receiveString(uart, text);
+    receiveString(uart, text);
+    uart.serviceSoftwareBuffers();
+    uart.readData(drain, sizeof(drain));
+    
+    // 240 bytes consumed: a 40-byte line wraps the 256-byte ring
+    char line[64];
+    size_t length = 0;
+    memset(text, 'w', 39);
+    text[39] = '\n';
+    text[40] = '\0';
+    receiveString(uart, text);
+    uart.serviceSoftwareBuffers();
+    TEST("Line wrapping the software ring read", uart.readLine(line, sizeof(line), length));
+    TEST("Wrapped line intact", length == 39 && line[0] == 'w' && line[38] == 'w' && line[39] == '\0');
+    TEST("Nothing left over", !uart.hasData());
+}
+
+int runReadLineTests() {
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "Running readUntil/readLine Tests" << std::endl;
+    std::cout << "========================================" << std::endl;
+    
+    testReadUntil();
+    testReadLine();
+    testReadLineBuffered();
+    
+    return tests_failed;
+}
+
+} // namespace test
+} // namespace uart
@@ -0,0 +1,153 @@
+#include "uart_shm.h"
+#include <algorithm>
+#include <iostream>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace uart {
+namespace test {
+
+extern int tests_run;
+extern int tests_passed;
+extern int tests_failed;
+extern void reportTest(const char* name, bool passed);
+
+#define TEST(name, condition) \
+    reportTest(name, (condition))
+
+#if defined(__linux__)
+
+static void shmName(char* name, size_t size, const char* tag) {
+    snprintf(name, size, "/uart_shm_test_%s_%ld", tag, static_cast<long>(getpid()));
+}
+
+void testShmRegion() {
+    std::cout << "\n=== Shared Memory Region Tests ===" << std::endl;
+    
+    char name[64];
+    shmName(name, sizeof(name), "region");
+    
+    ShmUART app;
+    ShmUART device;
+    TEST("Region created", app.create(name));
+    TEST("Duplicate name rejected", !ShmUART().create(name));
+    TEST("Peer attaches", device.attach(name));
+    TEST("Mismatched layout rejected", !(BasicShmUART<64, 64>().attach(name)));
+    TEST("Name removed", ShmUART::unlink(name));
+    
+    app.driver().initialize(115200);
+    TEST("Control shared with the peer", (device.driver().readControl() & CTRL_ENABLE) != 0);
+    
+    uint8_t data[20];
+    for (int i = 0; i < 20; i++) {
+        data[i] = static_cast<uint8_t>(i);
+    }
+    TEST("Write stops at FIFO depth", app.writeData(data, 20) == FIFO_DEPTH);
+    TEST("Peer sees TX full", (device.driver().readStatus() & STATUS_TX_FULL) != 0);
+    uint8_t out[FIFO_DEPTH];
+    TEST("Device drains the shared FIFO", device.drainTx(out, sizeof(out)) == FIFO_DEPTH && out[15] == 15);
+    
+    ReceiveResult result = device.simulateReceive(data, 20);
+    TEST("Device overruns RX", result.accepted == FIFO_DEPTH && result.dropped == 20 - FIFO_DEPTH);
+    TEST("Application sees the overrun", app.driver().hasError());
+    uint8_t in[FIFO_DEPTH];
+    TEST("Application reads received data", app.readData(in, sizeof(in)) == FIFO_DEPTH && in[3] == 3);
+    app.driver().clearErrors();
+    TEST("Errors cleared for both sides", !device.driver().hasError());
+    PortStats app_stats = app.driver().getStats();
+    PortStats device_stats = device.driver().getStats();
+    TEST("Each side counts its own traffic",
+         app_stats.tx_full_rejects == 1 && app_stats.tx_bytes == 0 &&
+         device_stats.tx_bytes == FIFO_DEPTH && device_stats.rx_dropped_bytes == 20 - FIFO_DEPTH);
+    
+    TEST("Nothing waits on the fast path", app.getStats().wakes == 0 && device.getStats().wakes == 0 &&
+                                          app.getStats().waits == 0 && device.getStats().waits == 0);
+    TEST("Wait times out when idle", !app.waitReadable(10));
+    
+    app.shutdown();
+    TEST("Waits end when the port is disabled", !device.waitTransmitData(-1));
+}
+
+void testShmCrossProcess() {
+    std::cout << "\n=== Shared Memory Cross-Process Tests ===" << std::endl;
+    
+    char name[64];
+    shmName(name, sizeof(name), "echo");
+    
+    ShmUART app;
+    app.create(name);
+    app.driver().initialize(115200);
+    
+    pid_t child = fork();
+    if (child == 0) {
+        // Device model: echo everything the application transmits
+        ShmUART device;
+        if (!device.attach(name)) {
+            _exit(1);
+        }
+        uint8_t block[FIFO_DEPTH];
+        while (device.waitTransmitData(-1)) {
+            size_t n = device.drainTx(block, sizeof(block));
+            size_t done = 0;
+            while (done < n && device.waitReceiveSpace(-1)) {
+                // Offer only what fits so nothing is dropped as an overrun
+                size_t space = device.driver().getRxSpace();
+                done += device.simulateReceive(block + done, std::min(space, n - done)).accepted;
+            }
+        }
+        _exit(0);
+    }
+    
+    const size_t total = 64 * 1024;
+    std::vector<uint8_t> sent(total);
+    std::vector<uint8_t> echoed(total);
+    for (size_t i = 0; i < total; i++) {
+        sent[i] = static_cast<uint8_t>(i * 7 + (i >> 8));
+    }
+    size_t written = 0;
+    size_t received = 0;
+    while (received < total) {
+        if (written < total) {
+            written += app.writeData(sent.data() + written, total - written);
+        }
+        size_t n = app.readData(echoed.data() + received, total - received);
+        received += n;
+        if (n == 0 && !app.waitReadable(1000)) {
+            break;
+        }
+    }
+    app.shutdown();
+    
+    int status = -1;
+    waitpid(child, &status, 0);
+    ShmUART::unlink(name);
+    
+    TEST("Echo process attached and exited cleanly", WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    TEST("Every byte echoed across processes", received == total);
+    TEST("Echoed data intact", received == total && memcmp(sent.data(), echoed.data(), total) == 0);
+    TEST("No overruns with flow control by waiting", !app.driver().hasError());
+}
+
+#endif
+
+int runShmTests() {
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "Running Shared Memory Tests" << std::endl;
+    std::cout << "========================================" << std::endl;
+    
+#if defined(__linux__)
+    testShmRegion();
+    testShmCrossProcess();
+#endif
+    
+    return tests_failed;
+}
+
+} // namespace test
+} // namespace uart
@@ -0,0 +1,156 @@
+#include "uart_driver.h"
+#include <iostream>
+#include <cstring>
+#include <thread>
+
+namespace uart {
+namespace test {
+
+extern int tests_run;
+extern int tests_passed;
+extern int tests_failed;
+extern void reportTest(const char* name, bool passed);
+
+#define TEST(name, condition) \
+    reportTest(name, (condition))
+
+void testTrafficCounters() {
+    std::cout << "\n=== Traffic Counter Tests ===" << std::endl;
+    
+    UARTDriver uart;
+    uart.initialize(115200);
+    
+    PortStats stats = uart.getStats();
+    TEST("Counters start at zero", stats.tx_bytes == 0 && stats.rx_bytes == 0 && stats.overrun_events == 0);
+    
+    uint8_t data[24];
+    for (int i = 0; i < 24; i++) {
+        data[i] = static_cast<uint8_t>(i);
+    }
+    
+    uart.writeData(data, 10);
+    uart.simulateTransmit(6);
+    uart.simulateReceive(data, 5);
+    
+    stats = uart.getStats();
+    TEST("TX bytes counted on transmit", stats.tx_bytes == 6);
+    TEST("RX bytes counted on receive", stats.rx_bytes == 5);
+    TEST("TX high-water mark", stats.tx_high_water == 10);
+    TEST("RX high-water mark", stats.rx_high_water == 5);
+    TEST("No rejections yet", stats.tx_full_rejects == 0);
+    
+    // Fill the TX FIFO past capacity: one short write, one rejected byte
+    uart.writeData(data, 24);
+    uart.writeByte(0xAA);
+    stats = uart.getStats();
+    TEST("Short write and full writeByte rejected", stats.tx_full_rejects == 2);
+    TEST("TX high-water reaches depth", stats.tx_high_water == FIFO_DEPTH);
+}
+
+void testOverrunAndErrorCounters() {
+    std::cout << "\n=== Overrun and Error Counter Tests ===" << std::endl;
+    
+    UARTDriver uart;
+    uart.initialize(115200, true, false);
+    
+    uint8_t data[20];
+    memset(data, 0x55, sizeof(data));
+    uart.simulateReceive(data, 20);
+    
+    PortStats stats = uart.getStats();
+    TEST("Overrun event counted", stats.overrun_events == 1);
+    TEST("Dropped bytes counted", stats.rx_dropped_bytes == 20 - FIFO_DEPTH);
+    TEST("Accepted bytes counted", stats.rx_bytes == FIFO_DEPTH);
+    TEST("RX high-water at depth", stats.rx_high_water == FIFO_DEPTH);
+    TEST("Full FIFO lands in top bucket", stats.rx_occupancy[OCCUPANCY_BUCKETS - 1] == 1);
+    
+    uint8_t drained[FIFO_DEPTH];
+    uart.readData(drained, sizeof(drained));
+    
+    // 0x55 has even weight, so even parity expects 0; claim 1 for three chars
+    uint8_t parity[1] = {0x07};
+    uart.simulateReceive(data, 8, parity);
+    stats = uart.getStats();
+    TEST("Frame errors counted per character", stats.frame_errors == 3);
+    
+    uart.resetStats();
+    stats = uart.getStats();
+    TEST("Reset clears counters", stats.frame_errors == 0 && stats.rx_bytes == 0 && stats.rx_high_water == 0);
+    TEST("Reset clears histogram", stats.rx_occupancy[OCCUPANCY_BUCKETS - 1] == 0);
+}
+
+void testOccupancyHistogram() {
+    std::cout << "\n=== Occupancy Histogram Tests ===" << std::endl;
+    
+    UARTDriver uart;
+    uart.initialize(115200);
+    
+    uint8_t data[FIFO_DEPTH] = {0};
+    uint8_t drained[FIFO_DEPTH];
+    
+    // One burst landing at each level 1..FIFO_DEPTH, draining after each
+    for (size_t level = 1; level <= FIFO_DEPTH; level++) {
+        uart.simulateReceive(data, level);
+        uart.readData(drained, sizeof(drained));
+    }
+    
+    PortStats stats = uart.getStats();
+    uint64_t total = 0;
+    for (size_t i = 0; i < OCCUPANCY_BUCKETS; i++) {
+        total += stats.rx_occupancy[i];
+    }
+    TEST("Histogram counts every burst", total == FIFO_DEPTH);
+    TEST("Low bucket holds near-empty samples", stats.rx_occupancy[0] == 1);
+    TEST("Top bucket holds near-full samples", stats.rx_occupancy[OCCUPANCY_BUCKETS - 1] == 3);
+}
+
+void testConcurrentSnapshot() {
+    std::cout << "\n=== Concurrent Snapshot Tests ===" << std::endl;
+    
+    UARTDriver uart;
+    uart.initialize(115200);
+    
+    const size_t bursts = 20000;
+    std::thread device([&uart]() {
+        uint8_t byte = 0x42;
+        for (size_t i = 0; i < bursts; i++) {
+            uart.simulateReceive(&byte, 1);
+        }
+    });
+    
+    // Snapshots taken while the device side counts must never go backwards
+    bool monotonic = true;
+    uint64_t last = 0;
+    uint8_t drained[FIFO_DEPTH];
+    for (;;) {
+        uart.readData(drained, sizeof(drained));
+        PortStats stats = uart.getStats();
+        uint64_t seen = stats.rx_bytes + stats.rx_dropped_bytes;
+        monotonic = monotonic && seen >= last;
+        last = seen;
+        if (seen == bursts) {
+            break;
+        }
+    }
+    device.join();
+    
+    PortStats stats = uart.getStats();
+    TEST("Snapshots are monotonic", monotonic);
+    TEST("Every burst accounted for", stats.rx_bytes + stats.rx_dropped_bytes == bursts);
+}
+
+int runStatsTests() {
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "Running Statistics Tests" << std::endl;
+    std::cout << "========================================" << std::endl;
+    
+    testTrafficCounters();
+    testOverrunAndErrorCounters();
+    testOccupancyHistogram();
+    testConcurrentSnapshot();
+    
+    return tests_failed;
+}
+
+} // namespace test
+} // namespace uart
@@ -0,0 +1,118 @@
+#include "uart_stress.h"
+#include <iostream>
+#include <vector>
+
+namespace uart {
+namespace test {
+
+extern int tests_run;
+extern int tests_passed;
+extern int tests_failed;
+extern void reportTest(const char* name, bool passed);
+
+#define TEST(name, condition) \
+    reportTest(name, (condition))
+
+using namespace stress;
+
+// Planted bug: reports TX full one byte early, like a depth - 1 off-by-one
+class EarlyFullDriver : public UARTDriver {
+public:
+    uint32_t readStatus() const {
+        uint32_t status = UARTDriver::readStatus();
+        if (getTxFifoCount() == FIFO_DEPTH - 1) {
+            status |= STATUS_TX_FULL;
+        }
+        return status;
+    }
+};
+
+void testSequenceGeneration() {
+    std::cout << "\n=== Stress Sequence Generation Tests ===" << std::endl;
+    
+    std::vector<StressOperation> a;
+    std::vector<StressOperation> b;
+    generateStressSequence(sequenceSeed(7, 1000), 64, 40, a);
+    generateStressSequence(sequenceSeed(7, 1000), 64, 40, b);
+    TEST("Same seed, same sequence", a == b);
+    generateStressSequence(sequenceSeed(7, 1001), 64, 40, b);
+    TEST("Next index, different sequence", a != b);
+    
+    bool bounded = true;
+    bool seen[STRESS_OP_COUNT] = {};
+    for (uint64_t i = 0; i < 200; i++) {
+        generateStressSequence(sequenceSeed(1, i), 64, 40, a);
+        bounded = bounded && !a.empty() && a.size() <= 64;
+        for (size_t j = 0; j < a.size(); j++) {
+            bounded = bounded && a[j].kind < STRESS_OP_COUNT && a[j].length <= 40;
+            seen[a[j].kind] = true;
+        }
+    }
+    bool all_kinds = true;
+    for (size_t k = 0; k < STRESS_OP_COUNT; k++) {
+        all_kinds = all_kinds && seen[k];
+    }
+    TEST("Sequences within limits", bounded);
+    TEST("Every operation generated", all_kinds);
+}
+
+void testDriverMatchesModel() {
+    std::cout << "\n=== Driver vs Reference Model Tests ===" << std::endl;
+    
+    StressConfig config;
+    config.seed = 2024;
+    config.sequences = 20000;
+    config.seconds = 0.0;
+    config.threads = 2;
+    
+    StressResult result = runStress<UARTDriver>(config);
+    TEST("16/16 FIFO driver matches the model", !result.failed);
+    TEST("Every sequence run", result.sequences == config.sequences);
+    if (result.failed) {
+        std::cout << "  sequence " << result.failing_index << " step " << result.mismatch.step
+                  << ": " << result.mismatch.what << std::endl;
+    }
+    
+    result = runStress<BasicUARTDriver<4, 8> >(config);
+    TEST("4/8 FIFO driver matches the model", !result.failed);
+}
+
+void testPlantedBugFound() {
+    std::cout << "\n=== Stress Failure and Shrinking Tests ===" << std::endl;
+    
+    StressConfig config;
+    config.seed = 99;
+    config.sequences = 5000;
+    config.seconds = 0.0;
+    config.threads = 3;
+    
+    StressResult result = runStress<EarlyFullDriver>(config);
+    TEST("Planted bug found", result.failed);
+    TEST("Shrunk to at most two operations", result.failing_ops.size() >= 1 && result.failing_ops.size() <= 2);
+    TEST("Shrunk sequence no longer than original", result.failing_ops.size() <= result.original_length);
+    TEST("Mismatch names the status register", strstr(result.mismatch.what, "status") != nullptr);
+    
+    StressBuffers buffers;
+    StressMismatch mismatch;
+    TEST("Shrunk sequence still fails",
+         !runStressSequence<EarlyFullDriver>(result.failing_ops.data(), result.failing_ops.size(), buffers, mismatch));
+    
+    config.threads = 1;
+    StressResult again = runStress<EarlyFullDriver>(config);
+    TEST("Same failure regardless of thread count", again.failed && again.failing_index == result.failing_index);
+}
+
+int runStressTests() {
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "Running Stress Engine Tests" << std::endl;
+    std::cout << "========================================" << std::endl;
+    
+    testSequenceGeneration();
+    testDriverMatchesModel();
+    testPlantedBugFound();
+    
+    return tests_failed;
+}
+
+} // namespace test
+} // namespace uart
@@ -0,0 +1,216 @@
+#include "uart_time_engine.h"
+#include <iostream>
+#include <cstring>
+#include <vector>
+
+namespace uart {
+namespace test {
+
+extern int tests_run;
+extern int tests_passed;
+extern int tests_failed;
+extern void reportTest(const char* name, bool passed);
+
+#define TEST(name, condition) \
+    reportTest(name, (condition))
+
+void testCharacterTime() {
+    std::cout << "\n=== Character Time Tests ===" << std::endl;
+    
+    UARTDriver uart8n1;
+    uart8n1.initialize(115200);
+    TEST("8N1 uses 10 bits", uart8n1.getBitsPerCharacter() == 10);
+    TEST("8N1 at 115200 is 86806 ns", uart8n1.getCharacterTimeNs() == 86806);
+    
+    UARTDriver uart8e2;
+    uart8e2.initialize(9600, true, false, true);
+    TEST("8E2 uses 12 bits", uart8e2.getBitsPerCharacter() == 12);
+    TEST("8E2 at 9600 is 1250000 ns", uart8e2.getCharacterTimeNs() == 1250000);
+}
+
+void testTransmitPacing() {
+    std::cout << "\n=== TX Pacing Tests ===" << std::endl;
+    
+    UARTDriver uart;
+    uart.initialize(1000000);  // 10 us per character
+    UARTTimeEngine engine(uart);
+    const uint64_t ct = uart.getCharacterTimeNs();
+    
+    uint8_t data[FIFO_DEPTH] = {0};
+    uart.writeData(data, FIFO_DEPTH);
+    
+    engine.runUntil(5 * ct + 1);
+    TEST("Five characters sent after 5 character times", uart.getTxFifoCount() == FIFO_DEPTH - 5);
+    TEST("Clock at requested time", engine.now() == 5 * ct + 1);
+    
+    engine.runToIdle();
+    TEST("Idle after whole FIFO shifted out", engine.idle() && uart.getTxFifoCount() == 0);
+    TEST("Idle time is 16 character times", engine.now() == FIFO_DEPTH * ct);
+    
+    const LinkTimingStats& stats = engine.getStats();
+    TEST("TX byte count", stats.tx_bytes == FIFO_DEPTH);
+    TEST("Line fully utilized", stats.txUtilization() > 0.999);
+    // Occupancy 16+15+...+1 character times over 16 bytes
+    TEST("Mean TX delay is 8.5 character times", stats.meanTxDelayNs() == 8.5 * ct);
+}
+
+struct TriggerLog {
+    UARTTimeEngine* engine;
+    UARTDriver* uart;
+    std::vector<uint64_t> times;
+};
+
+static void onRxTrigger(uint32_t pending, void* context) {
+    TriggerLog* log = static_cast<TriggerLog*>(context);
+    if (pending & INT_RX_TRIGGER) {
+        log->times.push_back(log->engine->now());
+        uint8_t buffer[FIFO_DEPTH];
+        log->uart->readData(buffer, sizeof(buffer));
+    }
+}
+
+void testReceivePacing() {
+    std::cout << "\n=== RX Pacing Tests ===" << std::endl;
+    
+    UARTDriver uart;
+    uart.initialize(1000000);
+    UARTTimeEngine engine(uart);
+    const uint64_t ct = uart.getCharacterTimeNs();
+    
+    uint8_t data[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+    engine.scheduleReceive(data, sizeof(data), 0);
+    engine.runUntil(3 * ct);
+    TEST("Three characters arrived by 3 character times", uart.getRxFifoCount() == 3);
+    
+    engine.runToIdle();
+    TEST("All characters arrived", uart.getRxFifoCount() == 8);
+    TEST("Arrival ends at 8 character times", engine.now() == 8 * ct);
+    TEST("Every character counted as accepted", engine.getStats().rx_bytes == 8 && engine.getStats().rx_dropped_bytes == 0);
+    
+    // Nobody reads after this: the FIFO overruns and the excess is dropped
+    uint8_t drain[8];
+    uart.readData(drain, sizeof(drain));
+    uint8_t burst[FIFO_DEPTH + 4] = {0};
+    engine.scheduleReceive(burst, sizeof(burst));
+    engine.runToIdle();
+    TEST("Overrun bytes not counted as received", engine.getStats().rx_bytes == 8 + FIFO_DEPTH);
+    TEST("Overrun bytes counted as dropped", engine.getStats().rx_dropped_bytes == 4);
+    TEST("Engine agrees with the port counters",
+         uart.getStats().rx_bytes == engine.getStats().rx_bytes &&
+         uart.getStats().rx_dropped_bytes == engine.getStats().rx_dropped_bytes);
+    
+    // Trigger-level interrupts fire exactly when the level is reached
+    UARTDriver uart2;
+    uart2.initialize(1000000);
+    UARTTimeEngine engine2(uart2);
+    TriggerLog log;
+    log.engine = &engine2;
+    log.uart = &uart2;
+    uart2.setInterruptHandler(&onRxTrigger, &log);
+    uart2.configureInterrupts(INT_RX_TRIGGER, FCR_RX_TRIG_QUARTER);
+    
+    engine2.scheduleReceive(data, sizeof(data), 0);
+    engine2.runToIdle();
+    TEST("Two trigger interrupts", log.times.size() == 2);
+    TEST("Interrupts at 4 and 8 character times",
+         log.times.size() == 2 && log.times[0] == 4 * ct && log.times[1] == 8 * ct);
+}
+
+void testFullDuplexOrdering() {
+    std::cout << "\n=== Full-Duplex Timing Tests ===" << std::endl;
+    
+    UARTDriver uart;
+    uart.initialize(1000000);
+    UARTTimeEngine engine(uart);
+    const uint64_t ct = uart.getCharacterTimeNs();
+    
+    uint8_t data[FIFO_DEPTH] = {0};
+    uart.writeData(data, 10);
+    engine.scheduleReceive(data, 4, 2 * ct);
+    
+    engine.runUntil(4 * ct);
+    TEST("TX and RX advance together", uart.getTxFifoCount() == 6 && uart.getRxFifoCount() == 2);
+    
+    engine.runToIdle();
+    TEST("Full-duplex run completes", uart.getTxFifoCount() == 0 && uart.getRxFifoCount() == 4);
+    TEST("Line time set by the longer direction", engine.now() == 10 * ct);
+}
+
+static void recordLine(const ConstByteRegions& data, void* context) {
+    std::vector<uint8_t>* line = static_cast<std::vector<uint8_t>*>(context);
+    line->insert(line->end(), data.first.data, data.first.data + data.first.size);
+    line->insert(line->end(), data.second.data, data.second.data + data.second.size);
+}
+
+void testFlowControlPacing() {
+    std::cout << "\n=== Flow Control Timing Tests ===" << std::endl;
+    
+    UARTDriver uart;
+    uart.initialize(1000000);
+    uart.configureFlowControl(CTRL_RTSCTS);
+    UARTTimeEngine engine(uart);
+    const uint64_t ct = uart.getCharacterTimeNs();
+    
+    uint8_t data[FIFO_DEPTH] = {0};
+    uart.setCts(false);
+    uart.writeData(data, 4);
+    engine.runUntil(100 * ct);
+    TEST("CTS low: nothing counted as sent", engine.getStats().tx_bytes == 0);
+    TEST("CTS low: line not busy", engine.getStats().txUtilization() == 0.0);
+    TEST("CTS low: data stays queued", uart.getTxFifoCount() == 4);
+    TEST("CTS low: run to idle returns", engine.runToIdle() == 100 * ct);
+    
+    uart.setCts(true);
+    engine.runToIdle();
+    TEST("CTS high: transmitter re-armed", uart.getTxFifoCount() == 0 && engine.getStats().tx_bytes == 4);
+    TEST("CTS high: resumes a character later", engine.now() == 104 * ct);
+    
+    UARTDriver soft;
+    soft.initialize(1000000);
+    soft.configureFlowControl(CTRL_XONXOFF, 8, 2);
+    std::vector<uint8_t> line;
+    soft.setTxSink(&recordLine, &line);
+    UARTTimeEngine engine2(soft);
+    
+    uint8_t xoff = XOFF_CHAR;
+    uint8_t xon = XON_CHAR;
+    soft.writeData(data, 6);
+    engine2.scheduleReceive(&xoff, 1, 0);
+    engine2.runUntil(100 * ct);
+    TEST("XOFF: transmitter stops after the character in flight",
+         soft.getTxFifoCount() == 5 && engine2.getStats().tx_bytes == 1);
+    
+    engine2.scheduleReceive(&xon, 1);
+    engine2.runToIdle();
+    TEST("XON: transmitter re-armed", soft.getTxFifoCount() == 0 && engine2.getStats().tx_bytes == 6);
+    TEST("XON: resumes a character after it arrives", engine2.now() == 106 * ct);
+    
+    // Filling our receiver past the stop level makes the driver send XOFF
+    line.clear();
+    engine2.resetStats();
+    engine2.scheduleReceive(data, 8);
+    engine2.runToIdle();
+    TEST("Injected XOFF counted", engine2.getStats().tx_bytes == 1 && line.size() == 1 && line[0] == XOFF_CHAR);
+    
+    uint8_t buffer[FIFO_DEPTH];
+    soft.readData(buffer, 6);
+    engine2.runToIdle();
+    TEST("Injected XON counted", engine2.getStats().tx_bytes == 2 && line.size() == 2 && line[1] == XON_CHAR);
+}
+
+int runTimingTests() {
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "Running Virtual Time Tests" << std::endl;
+    std::cout << "========================================" << std::endl;
+    
+    testCharacterTime();
+    testTransmitPacing();
+    testReceivePacing();
+    testFullDuplexOrdering();
+    testFlowControlPacing();
+    
+    return tests_failed;
+}
+
+} // namespace test
+} // namespace uart
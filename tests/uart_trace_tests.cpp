@@ -0,0 +1,258 @@
+#include "uart_trace.h"
+#include <iostream>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace uart {
+namespace test {
+
+extern int tests_run;
+extern int tests_passed;
+extern int tests_failed;
+extern void reportTest(const char* name, bool passed);
+
+#define TEST(name, condition) \
+    reportTest(name, (condition))
+
+static const char* TRACE_PATH = "uart_trace_test.bin";
+
+// A short session touching every traced call
+static void runSession(UARTDriver& uart, bool paced) {
+    uint8_t data[40];
+    for (int i = 0; i < 40; i++) {
+        data[i] = static_cast<uint8_t>(i * 3 + 1);
+    }
+    uart.writeData(data, 10);
+    uart.writeByte(0x7E);
+    uart.simulateTransmit(4);
+    if (paced) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    uart.simulateReceive(data, 12);
+    uart.simulateReceive(data + 12, 9);   // Overruns the 16-byte FIFO
+    uart.writeData(data, 13);             // Partly rejected
+    uart.simulateTransmit(3);
+}
+
+static bool sameState(UARTDriver& a, UARTDriver& b) {
+    PortStats sa = a.getStats();
+    PortStats sb = b.getStats();
+    if (sa.tx_bytes != sb.tx_bytes || sa.rx_bytes != sb.rx_bytes ||
+        sa.rx_dropped_bytes != sb.rx_dropped_bytes || sa.tx_full_rejects != sb.tx_full_rejects ||
+        a.getTxFifoCount() != b.getTxFifoCount() || a.readStatus() != b.readStatus()) {
+        return false;
+    }
+    uint8_t ra[FIFO_DEPTH];
+    uint8_t rb[FIFO_DEPTH];
+    size_t na = a.readData(ra, sizeof(ra));
+    size_t nb = b.readData(rb, sizeof(rb));
+    return na == nb && memcmp(ra, rb, na) == 0;
+}
+
+void testTraceRecordReplay() {
+    std::cout << "\n=== Trace Record/Replay Tests ===" << std::endl;
+    
+    UARTDriver original;
+    original.initialize(115200);
+    TraceRecorder recorder;
+    TEST("Recorder opens", recorder.open(TRACE_PATH));
+    recorder.attach(original);
+    runSession(original, false);
+    recorder.detach(original);
+    TEST("Every call recorded", recorder.getRecordCount() == 7);
+    TEST("Recorder closes cleanly", recorder.close());
+    
+    TraceReader reader;
+    TEST("Reader maps trace", reader.open(TRACE_PATH));
+    TraceEvent event;
+    TEST("First event is the write", reader.next(event) && event.event == TRACE_TX_WRITE && event.length == 10);
+    TEST("Payload read in place", event.data && event.data[1] == 4);
+    TEST("writeByte recorded as a 1-byte write", reader.next(event) && event.length == 1 && event.data[0] == 0x7E);
+    TEST("Transmit has no payload", reader.next(event) && event.event == TRACE_TX_DONE && !event.data);
+    
+    reader.rewind();
+    UARTDriver replica;
+    replica.initialize(115200);
+    TEST("Replay visits every event", replayTrace(reader, replica) == 7);
+    TEST("Replica matches the original", sameState(original, replica));
+    TEST("Trace not truncated", !reader.isTruncated());
+}
+
+void testTraceTransmitAccounting() {
+    std::cout << "\n=== Trace Transmit Accounting Tests ===" << std::endl;
+    
+    UARTDriver original;
+    original.initialize(115200);
+    TraceRecorder recorder;
+    recorder.open(TRACE_PATH);
+    recorder.attach(original);
+    
+    uint8_t data[12];
+    for (int i = 0; i < 12; i++) {
+        data[i] = static_cast<uint8_t>(0xA0 + i);
+    }
+    original.simulateTransmit(8);           // Nothing queued: not recorded
+    original.writeData(data, 10);
+    original.simulateTransmit(10);
+    ByteRegions space = original.reserveTx(12);
+    memcpy(space.first.data, data, space.first.size);
+    memcpy(space.second.data, data + space.first.size, space.second.size);
+    original.commitTx(12);                  // Zero-copy write across the wrap
+    original.simulateTransmit(100);         // Records the 12 actually sent
+    original.simulateTransmit(100);         // Idle again
+    recorder.detach(original);
+    TEST("Idle transmits leave no record", recorder.getRecordCount() == 5);
+    recorder.close();
+    
+    TraceReader reader;
+    reader.open(TRACE_PATH);
+    TraceEvent event;
+    reader.next(event);
+    TEST("Transmit records the count sent", reader.next(event) && event.event == TRACE_TX_DONE &&
+                                            event.length == 10);
+    TEST("Commit recorded as writes of each segment",
+         reader.next(event) && event.event == TRACE_TX_WRITE && event.length == 6 && event.data[0] == 0xA0 &&
+         reader.next(event) && event.event == TRACE_TX_WRITE && event.length == 6 && event.data[0] == 0xA6);
+    TEST("Transmit after commit records the 12 sent",
+         reader.next(event) && event.event == TRACE_TX_DONE && event.length == 12);
+    
+    reader.rewind();
+    UARTDriver replica;
+    replica.initialize(115200);
+    replayTrace(reader, replica);
+    TEST("Replay reproduces zero-copy writes", sameState(original, replica) &&
+                                               replica.getStats().tx_bytes == 22);
+}
+
+void testTracePacing() {
+    std::cout << "\n=== Trace Pacing Tests ===" << std::endl;
+    
+    {
+        UARTDriver uart;
+        uart.initialize(115200);
+        TraceRecorder recorder;
+        recorder.open(TRACE_PATH);
+        recorder.attach(uart);
+        runSession(uart, true);
+        recorder.close();
+    }
+    
+    TraceReader reader;
+    reader.open(TRACE_PATH);
+    UARTDriver fast;
+    fast.initialize(115200);
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    replayTrace(reader, fast, TRACE_AS_FAST_AS_POSSIBLE);
+    std::chrono::steady_clock::duration fast_time = std::chrono::steady_clock::now() - t0;
+    
+    reader.rewind();
+    UARTDriver paced;
+    paced.initialize(115200);
+    t0 = std::chrono::steady_clock::now();
+    replayTrace(reader, paced, TRACE_ORIGINAL_PACING);
+    std::chrono::steady_clock::duration paced_time = std::chrono::steady_clock::now() - t0;
+    
+    TEST("Paced replay keeps the recorded gap", paced_time >= std::chrono::milliseconds(20));
+    TEST("Fast replay skips the gap", fast_time < std::chrono::milliseconds(20));
+    TEST("Both replays reach the same state", sameState(fast, paced));
+}
+
+void testTraceTruncation() {
+    std::cout << "\n=== Trace Truncation Tests ===" << std::endl;
+    
+    {
+        UARTDriver uart;
+        uart.initialize(115200);
+        TraceRecorder recorder;
+        recorder.open(TRACE_PATH);
+        recorder.attach(uart);
+        runSession(uart, false);
+        recorder.close();
+    }
+    
+    // Chop the last record in half, as a crash mid-write would
+    std::FILE* file = std::fopen(TRACE_PATH, "rb");
+    std::vector<uint8_t> contents;
+    uint8_t chunk[4096];
+    size_t n;
+    while ((n = std::fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        contents.insert(contents.end(), chunk, chunk + n);
+    }
+    std::fclose(file);
+    file = std::fopen(TRACE_PATH, "wb");
+    std::fwrite(contents.data(), 1, contents.size() - 8, file);
+    std::fclose(file);
+    
+    TraceReader reader;
+    TEST("Truncated trace still maps", reader.open(TRACE_PATH));
+    TraceEvent event;
+    int count = 0;
+    while (reader.next(event)) {
+        count++;
+    }
+    TEST("Complete records read", count == 6);
+    TEST("Truncation reported", reader.isTruncated());
+    
+    file = std::fopen(TRACE_PATH, "wb");
+    std::fwrite("not a trace file", 1, 16, file);
+    std::fclose(file);
+    TEST("Bad header rejected", !reader.open(TRACE_PATH));
+    
+    std::remove(TRACE_PATH);
+}
+
+void testTraceOversizeEvent() {
+    std::cout << "\n=== Trace Oversize Event Tests ===" << std::endl;
+    
+    if (sizeof(size_t) <= sizeof(uint32_t)) {
+        return;  // No event can exceed a record on 32-bit targets
+    }
+    
+    // A transmit request past 4 GiB carries no payload, so it is cheap to record
+    uint64_t requested = (static_cast<uint64_t>(5) << 30) + 3;
+    TraceRecorder recorder;
+    recorder.open(TRACE_PATH);
+    TEST("Recorder reports open", recorder.isOpen());
+    recorder.record(TRACE_TX_DONE, nullptr, static_cast<size_t>(requested));
+    uint8_t tail[3] = {1, 2, 3};
+    recorder.record(TRACE_RX, tail, sizeof(tail));
+    TEST("Oversize event split into records", recorder.getRecordCount() == 3);
+    recorder.close();
+    TEST("Recorder reports closed", !recorder.isOpen());
+    
+    TraceReader reader;
+    reader.open(TRACE_PATH);
+    TraceEvent event;
+    uint64_t total = 0;
+    int split = 0;
+    while (reader.next(event) && event.event == TRACE_TX_DONE) {
+        total += event.length;
+        split++;
+    }
+    TEST("Split records add up to the event", split == 2 && total == requested);
+    TEST("Following record parses", event.event == TRACE_RX && event.length == 3 && event.data[2] == 3);
+    TEST("No truncation", !reader.isTruncated());
+    reader.close();
+    
+    std::remove(TRACE_PATH);
+}
+
+int runTraceTests() {
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "Running Trace Tests" << std::endl;
+    std::cout << "========================================" << std::endl;
+    
+    testTraceRecordReplay();
+    testTraceTransmitAccounting();
+    testTracePacing();
+    testTraceTruncation();
+    testTraceOversizeEvent();
+    
+    return tests_failed;
+}
+
+} // namespace test
+} // namespace uart
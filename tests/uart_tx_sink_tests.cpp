@@ -0,0 +1,206 @@
+#include "uart_driver.h"
+#include "uart_link.h"
+#include <iostream>
+#include <cstring>
+#include <vector>
+
+namespace uart {
+namespace test {
+
+extern int tests_run;
+extern int tests_passed;
+extern int tests_failed;
+extern void reportTest(const char* name, bool passed);
+
+#define TEST(name, condition) \
+    reportTest(name, (condition))
+
+// Collects everything the sink is given
+struct SinkCapture {
+    std::vector<uint8_t> bytes;
+    size_t calls;
+    size_t wrapped_calls;
+    bool well_formed;
+
+    SinkCapture() : calls(0), wrapped_calls(0), well_formed(true) {}
+
+    static void onTransmit(const ConstByteRegions& data, void* context) {
+        SinkCapture* self = static_cast<SinkCapture*>(context);
+        self->calls++;
+        if (data.first.size == 0) {
+            self->well_formed = false;  // Never called with nothing to send
+        }
+        if (data.second.size > 0) {
+            self->wrapped_calls++;
+        }
+        self->bytes.insert(self->bytes.end(), data.first.data, data.first.data + data.first.size);
+        if (data.second.size > 0) {
+            self->bytes.insert(self->bytes.end(), data.second.data, data.second.data + data.second.size);
+        }
+    }
+};
+
+void testTxSink() {
+    std::cout << "\n=== TX Sink Tests ===" << std::endl;
+    
+    UARTDriver uart;
+    uart.initialize(115200);
+    SinkCapture sink;
+    uart.setTxSink(&SinkCapture::onTransmit, &sink);
+    
+    uart.simulateTransmit(8);
+    TEST("Sink not called with nothing queued", sink.calls == 0);
+    
+    // Advance the ring so the next write wraps
+    uint8_t data[FIFO_DEPTH];
+    for (size_t i = 0; i < FIFO_DEPTH; i++) {
+        data[i] = static_cast<uint8_t>(0xA0 + i);
+    }
+    uart.writeData(data, 12);
+    uart.simulateTransmit(12);
+    sink.bytes.clear();
+    sink.calls = 0;
+    
+    uart.writeData(data, 10);
+    uart.simulateTransmit(16);
+    TEST("One call per transmit", sink.calls == 1);
+    TEST("Wrapped data given as two spans", sink.wrapped_calls == 1);
+    TEST("Sink sees bytes in line order", sink.bytes.size() == 10 && memcmp(sink.bytes.data(), data, 10) == 0);
+    TEST("Sent bytes leave the FIFO", uart.getTxFifoCount() == 0);
+    
+    sink.bytes.clear();
+    uart.writeData(data, 10);
+    uart.simulateTransmit(3);
+    TEST("Sink limited to the requested count", sink.bytes.size() == 3 && uart.getTxFifoCount() == 7);
+    
+    uint8_t out[FIFO_DEPTH];
+    size_t calls = sink.calls;
+    TEST("drainTx still returns the data", uart.drainTx(out, sizeof(out)) == 7 && out[0] == data[3]);
+    TEST("drainTx bypasses the sink", sink.calls == calls);
+    
+    uart.setTxSink(nullptr, nullptr);
+    uart.writeData(data, 4);
+    uart.simulateTransmit(4);
+    TEST("Removed sink not called", sink.calls == calls && uart.getTxFifoCount() == 0);
+    TEST("Sink never given an empty span", sink.well_formed);
+}
+
+void testTxSinkSoftwareTier() {
+    std::cout << "\n=== TX Sink Software Tier Tests ===" << std::endl;
+    
+    static uint8_t tx_arena[1024];
+    static uint8_t rx_arena[1024];
+    
+    UARTDriver uart;
+    uart.initialize(115200);
+    SoftwareBufferConfig config;
+    config.tx_memory = tx_arena;
+    config.tx_capacity = sizeof(tx_arena);
+    config.rx_memory = rx_arena;
+    config.rx_capacity = sizeof(rx_arena);
+    uart.attachSoftwareBuffers(config);
+    
+    SinkCapture sink;
+    uart.setTxSink(&SinkCapture::onTransmit, &sink);
+    
+    std::vector<uint8_t> message(700);
+    for (size_t i = 0; i < message.size(); i++) {
+        message[i] = static_cast<uint8_t>(i * 7);
+    }
+    uart.writeData(message.data(), message.size());
+    uart.simulateTransmit(300);
+    uart.simulateTransmit(1000);
+    TEST("Buffered bytes all reach the sink", sink.bytes == message);
+    TEST("Buffered transmit empties both tiers", uart.getTxBufferCount() == 0 && uart.getTxFifoCount() == 0);
+    TEST("Buffered sink calls well formed", sink.well_formed);
+}
+
+void testTxSinkFlowControl() {
+    std::cout << "\n=== TX Sink Flow Control Tests ===" << std::endl;
+    
+    UARTDriver uart;
+    uart.initialize(115200);
+    uart.configureFlowControl(CTRL_XONXOFF, 8, 2);
+    SinkCapture sink;
+    uart.setTxSink(&SinkCapture::onTransmit, &sink);
+    
+    uint8_t data[FIFO_DEPTH];
+    memset(data, 'r', sizeof(data));
+    uart.simulateReceive(data, 8);
+    uint8_t message[3] = {'a', 'b', 'c'};
+    uart.writeData(message, 3);
+    uart.simulateTransmit(16);
+    TEST("XOFF given in its own call", sink.calls == 2);
+    TEST("XOFF ahead of the data", sink.bytes.size() == 4 && sink.bytes[0] == XOFF_CHAR && sink.bytes[1] == 'a');
+}
+
+void testReceiveResult() {
+    std::cout << "\n=== Receive Result Tests ===" << std::endl;
+    
+    UARTDriver uart;
+    uart.initialize(115200);
+    
+    uint8_t data[24];
+    memset(data, 0x5A, sizeof(data));
+    ReceiveResult result = uart.simulateReceive(data, 10);
+    TEST("All accepted when it fits", result.accepted == 10 && result.dropped == 0);
+    result = uart.simulateReceive(data, 10);
+    TEST("Overrun reports the dropped bytes", result.accepted == 6 && result.dropped == 4);
+    result = uart.simulateReceive(data, 5);
+    TEST("Full FIFO drops everything", result.accepted == 0 && result.dropped == 5);
+    
+    uint8_t parity[3] = {0, 0, 0};
+    uart.initialize(115200, true);
+    result = uart.simulateReceive(data, 20, parity);
+    TEST("Parity receive reports the same way", result.accepted == 16 && result.dropped == 4);
+    
+    uart.initialize(115200);
+    uart.configureFlowControl(CTRL_XONXOFF);
+    data[0] = XOFF_CHAR;
+    data[1] = XON_CHAR;
+    result = uart.simulateReceive(data, 6);
+    TEST("XON/XOFF count as accepted", result.accepted == 6 && result.dropped == 0 && uart.getRxFifoCount() == 4);
+    
+    uart.shutdown();
+    result = uart.simulateReceive(data, 6);
+    TEST("Disabled receiver drops everything", result.accepted == 0 && result.dropped == 6);
+    result = uart.simulateReceive(nullptr, 6);
+    TEST("No data, nothing reported", result.accepted == 0 && result.dropped == 0);
+}
+
+void testLinkCountsDrops() {
+    std::cout << "\n=== Link Drop Count Tests ===" << std::endl;
+    
+    UARTDriver a;
+    UARTDriver b;
+    a.initialize(115200);
+    b.initialize(115200);
+    UARTLink link(a, b);
+    
+    uint8_t data[FIFO_DEPTH];
+    memset(data, 0x42, sizeof(data));
+    a.writeData(data, FIFO_DEPTH);
+    link.transfer();
+    a.writeData(data, 5);
+    link.transfer();
+    TEST("Link counts characters lost at the receiver", link.getStats(UARTLink::A_TO_B).dropped == 5);
+    link.resetStats();
+    TEST("Drop count reset", link.getStats(UARTLink::A_TO_B).dropped == 0);
+}
+
+int runTxSinkTests() {
+    std::cout << "\n========================================" << std::endl;
+    std::cout << "Running TX Sink and Receive Result Tests" << std::endl;
+    std::cout << "========================================" << std::endl;
+    
+    testTxSink();
+    testTxSinkSoftwareTier();
+    testTxSinkFlowControl();
+    testReceiveResult();
+    testLinkCountsDrops();
+    
+    return tests_failed;
+}
+
+} // namespace test
+} // namespace uart